@@ -14,8 +14,10 @@
  ** [[ Add lengthier description here ]]
  **/
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <limits>
 #include <map>
 #include <vector>
 #include <set>
@@ -31,10 +33,12 @@
 #include "Engine.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
+#include "Layer.h"
 #include "MarabouError.h"
 #include "InputParserError.h"
 #include "MString.h"
 #include "MaxConstraint.h"
+#include "NetworkLevelReasoner.h"
 #include "Options.h"
 #include "PiecewiseLinearConstraint.h"
 #include "PropertyParser.h"
@@ -118,6 +122,139 @@ void addAbsConstraint(InputQuery& ipq, unsigned b, unsigned f){
     ipq.addPiecewiseLinearConstraint(new AbsoluteValueConstraint(b, f));
 }
 
+/*
+  Bulk construction of input queries. Each function consumes whole NumPy
+  arrays in a single call, instead of one Python call per element. Arrays
+  of another dtype or layout are converted once, on the way in.
+*/
+typedef py::array_t<unsigned, py::array::c_style | py::array::forcecast> VariableArray;
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> ValueArray;
+typedef py::array_t<int, py::array::c_style | py::array::forcecast> TypeArray;
+
+void checkSize(const py::array &array, size_t size, const char *name){
+    if ( array.ndim() != 1 || (size_t)array.size() != size )
+        throw py::value_error( std::string( name ) + ": expected a 1-D array of size " +
+                               std::to_string( size ) );
+}
+
+void checkVariables(const InputQuery &ipq, const VariableArray &variables, const char *name){
+    const unsigned *data = variables.data();
+    unsigned numberOfVariables = ipq.getNumberOfVariables();
+    for ( ssize_t i = 0; i < variables.size(); ++i )
+        if ( data[i] >= numberOfVariables )
+            throw py::value_error( std::string( name ) + ": variable " +
+                                   std::to_string( data[i] ) + " is out of range" );
+}
+
+void markInputVariables(InputQuery &ipq, VariableArray variables){
+    checkSize( variables, variables.size(), "variables" );
+    checkVariables( ipq, variables, "variables" );
+    const unsigned *data = variables.data();
+    for ( ssize_t i = 0; i < variables.size(); ++i )
+        ipq.markInputVariable( data[i], i );
+}
+
+void markOutputVariables(InputQuery &ipq, VariableArray variables){
+    checkSize( variables, variables.size(), "variables" );
+    checkVariables( ipq, variables, "variables" );
+    const unsigned *data = variables.data();
+    for ( ssize_t i = 0; i < variables.size(); ++i )
+        ipq.markOutputVariable( data[i], i );
+}
+
+void setLowerBounds(InputQuery &ipq, VariableArray variables, ValueArray values){
+    checkSize( values, variables.size(), "values" );
+    checkVariables( ipq, variables, "variables" );
+    const unsigned *variableData = variables.data();
+    const double *valueData = values.data();
+    for ( ssize_t i = 0; i < variables.size(); ++i )
+        ipq.setLowerBound( variableData[i], valueData[i] );
+}
+
+void setUpperBounds(InputQuery &ipq, VariableArray variables, ValueArray values){
+    checkSize( values, variables.size(), "values" );
+    checkVariables( ipq, variables, "variables" );
+    const unsigned *variableData = variables.data();
+    const double *valueData = values.data();
+    for ( ssize_t i = 0; i < variables.size(); ++i )
+        ipq.setUpperBound( variableData[i], valueData[i] );
+}
+
+void addEquations(InputQuery &ipq, VariableArray offsets, VariableArray variables,
+                  ValueArray coefficients, ValueArray scalars, TypeArray types){
+    // Equation i is sum( coefficients[j] * variables[j] ) <type> scalars[i],
+    // for offsets[i] <= j < offsets[i + 1]
+    size_t numberOfEquations = scalars.size();
+    checkSize( scalars, numberOfEquations, "scalars" );
+    checkSize( types, numberOfEquations, "types" );
+    checkSize( offsets, numberOfEquations + 1, "offsets" );
+    checkSize( coefficients, variables.size(), "coefficients" );
+    checkVariables( ipq, variables, "variables" );
+
+    const unsigned *offsetData = offsets.data();
+    const unsigned *variableData = variables.data();
+    const double *coefficientData = coefficients.data();
+    const double *scalarData = scalars.data();
+    const int *typeData = types.data();
+    for ( size_t i = 0; i < numberOfEquations; ++i )
+    {
+        if ( offsetData[i] > offsetData[i + 1] || offsetData[i + 1] > (size_t)variables.size() )
+            throw py::value_error( "offsets: invalid addends of equation " + std::to_string( i ) );
+        if ( typeData[i] < Equation::EQ || typeData[i] > Equation::LE )
+            throw py::value_error( "types: invalid type of equation " + std::to_string( i ) );
+
+        Equation equation( (Equation::EquationType)typeData[i] );
+        for ( unsigned j = offsetData[i]; j < offsetData[i + 1]; ++j )
+            equation.addAddend( coefficientData[j], variableData[j] );
+        equation.setScalar( scalarData[i] );
+        ipq.addEquation( equation );
+    }
+}
+
+void addDenseEquations(InputQuery &ipq, ValueArray weights, VariableArray sourceVariables,
+                       VariableArray targetVariables, ValueArray biases){
+    // A fully connected layer: for every target t,
+    // sum( weights[t][s] * sourceVariables[s] ) + biases[t] = targetVariables[t]
+    if ( weights.ndim() != 2 )
+        throw py::value_error( "weights: expected a 2-D array" );
+    size_t numberOfTargets = weights.shape( 0 );
+    size_t numberOfSources = weights.shape( 1 );
+    checkSize( sourceVariables, numberOfSources, "sourceVariables" );
+    checkSize( targetVariables, numberOfTargets, "targetVariables" );
+    checkSize( biases, numberOfTargets, "biases" );
+    checkVariables( ipq, sourceVariables, "sourceVariables" );
+    checkVariables( ipq, targetVariables, "targetVariables" );
+
+    const double *weightData = weights.data();
+    const unsigned *sourceData = sourceVariables.data();
+    const unsigned *targetData = targetVariables.data();
+    const double *biasData = biases.data();
+    for ( size_t target = 0; target < numberOfTargets; ++target )
+    {
+        Equation equation;
+        const double *row = weightData + target * numberOfSources;
+        for ( size_t source = 0; source < numberOfSources; ++source )
+        {
+            // Zero weights do not contribute to the sum
+            if ( row[source] != 0 )
+                equation.addAddend( row[source], sourceData[source] );
+        }
+        equation.addAddend( -1, targetData[target] );
+        equation.setScalar( -biasData[target] );
+        ipq.addEquation( equation );
+    }
+}
+
+void addReluConstraints(InputQuery &ipq, VariableArray bVariables, VariableArray fVariables){
+    checkSize( fVariables, bVariables.size(), "fVariables" );
+    checkVariables( ipq, bVariables, "bVariables" );
+    checkVariables( ipq, fVariables, "fVariables" );
+    const unsigned *bData = bVariables.data();
+    const unsigned *fData = fVariables.data();
+    for ( ssize_t i = 0; i < bVariables.size(); ++i )
+        ipq.addPiecewiseLinearConstraint( new ReluConstraint( bData[i], fData[i] ) );
+}
+
 void loadProperty(InputQuery &inputQuery, std::string propertyFilePath)
 {
     String propertyFilePathM = String(propertyFilePath);
@@ -132,14 +269,10 @@ void loadProperty(InputQuery &inputQuery, std::string propertyFilePath)
 
 bool createInputQuery(InputQuery &inputQuery, std::string networkFilePath, std::string propertyFilePath){
   try{
-    AcasParser* acasParser = new AcasParser( String(networkFilePath) );
-    acasParser->generateQuery( inputQuery );
-
-    bool success = inputQuery.constructNetworkLevelReasoner();
-    if ( success )
-      printf("Successfully created a network level reasoner.\n");
-    else
-      printf("Warning: network level reasoner construction failed.\n");
+    // The parser constructs the network level reasoner along with the
+    // query, or throws an InputParserError
+    AcasParser acasParser( String(networkFilePath) );
+    acasParser.generateQuery( inputQuery );
 
     String propertyFilePathM = String(propertyFilePath);
     if ( propertyFilePath != "" )
@@ -406,10 +539,140 @@ std::tuple<std::string, std::map<int, double>, Statistics>
     return std::make_tuple(resultString, ret, retStats);
 }
 
+/*
+  Array access to the values stored in a query. The arrays are filled in
+  a single pass in C++, and NumPy takes over their storage without a
+  copy. Bounds of the network level reasoner are not copied at all: the
+  arrays are read-only views of the layers, which keep the query alive.
+*/
+py::array_t<double> toArray(std::vector<double> *values){
+    py::capsule owner( values, [](void *data){ delete (std::vector<double> *)data; } );
+    return py::array_t<double>( values->size(), values->data(), owner );
+}
+
+py::array_t<double> getSolutionValues(const InputQuery &ipq){
+    // Variables without a value, e.g. before solving, are NaN
+    std::vector<double> *values = new std::vector<double>
+        ( ipq.getNumberOfVariables(), std::numeric_limits<double>::quiet_NaN() );
+    for ( const auto &pair : ipq.getSolution() )
+        if ( pair.first < values->size() )
+            (*values)[pair.first] = pair.second;
+    return toArray( values );
+}
+
+py::array_t<double> getLowerBounds(const InputQuery &ipq){
+    std::vector<double> *values = new std::vector<double>
+        ( ipq.getNumberOfVariables(), FloatUtils::negativeInfinity() );
+    for ( const auto &pair : ipq.getLowerBounds() )
+        if ( pair.first < values->size() )
+            (*values)[pair.first] = pair.second;
+    return toArray( values );
+}
+
+py::array_t<double> getUpperBounds(const InputQuery &ipq){
+    std::vector<double> *values = new std::vector<double>
+        ( ipq.getNumberOfVariables(), FloatUtils::infinity() );
+    for ( const auto &pair : ipq.getUpperBounds() )
+        if ( pair.first < values->size() )
+            (*values)[pair.first] = pair.second;
+    return toArray( values );
+}
+
+py::tuple getLayerBounds(py::object self, unsigned layerIndex){
+    const InputQuery &ipq = self.cast<const InputQuery &>();
+    const NLR::NetworkLevelReasoner *nlr = ipq.getNetworkLevelReasoner();
+    if ( !nlr )
+        throw py::value_error( "The query has no network level reasoner" );
+    if ( layerIndex >= nlr->getNumberOfLayers() )
+        throw py::index_error( "Layer " + std::to_string( layerIndex ) + " is out of range" );
+
+    const NLR::Layer *layer = nlr->getLayer( layerIndex );
+    py::array_t<double> lbs( layer->getSize(), layer->getLbs(), self );
+    py::array_t<double> ubs( layer->getSize(), layer->getUbs(), self );
+    lbs.attr( "setflags" )( py::arg( "write" ) = false );
+    ubs.attr( "setflags" )( py::arg( "write" ) = false );
+    return py::make_tuple( lbs, ubs );
+}
+
+/*
+  A solver session keeps one network processed: the preprocessed query,
+  the network level reasoner and the tableau are built once, and each
+  call to solve only adds the bounds and equations of one property, in a
+  scope of the engine that is discarded afterwards.
+*/
+class SolverSession {
+public:
+    SolverSession(InputQuery &inputQuery, MarabouOptions &options)
+        : _numberOfVariables( inputQuery.getNumberOfVariables() )
+    {
+        options.setOptions();
+        _engine = std::unique_ptr<Engine>( new Engine() );
+        _feasible = _engine->processInputQuery( inputQuery );
+    }
+
+    std::tuple<std::string, std::map<int, double>, Statistics>
+        solve(VariableArray variables, ValueArray lowerBounds, ValueArray upperBounds,
+              std::vector<Equation> equations)
+    {
+        checkSize( lowerBounds, variables.size(), "lowerBounds" );
+        checkSize( upperBounds, variables.size(), "upperBounds" );
+
+        std::map<int, double> ret;
+        // The network alone is infeasible, and so is every property of it
+        if ( !_feasible )
+            return std::make_tuple( exitCodeToString( IEngine::UNSAT ), ret,
+                                    *_engine->getStatistics() );
+
+        const unsigned *variableData = variables.data();
+        const double *lowerBoundData = lowerBounds.data();
+        const double *upperBoundData = upperBounds.data();
+
+        _engine->push();
+        try
+        {
+            for ( ssize_t i = 0; i < variables.size(); ++i )
+            {
+                _engine->addPropertyBound( Tightening( variableData[i], lowerBoundData[i], Tightening::LB ) );
+                _engine->addPropertyBound( Tightening( variableData[i], upperBoundData[i], Tightening::UB ) );
+            }
+            for ( const auto &equation : equations )
+                _engine->addPropertyEquation( equation );
+
+            if ( _engine->solveIncrementally( Options::get()->getInt( Options::TIMEOUT ) ) )
+            {
+                InputQuery solution;
+                solution.setNumberOfVariables( _numberOfVariables );
+                _engine->extractSolution( solution );
+                for ( unsigned i = 0; i < _numberOfVariables; ++i )
+                    ret[i] = solution.getSolutionValue( i );
+            }
+        }
+        catch ( const MarabouError &e )
+        {
+            _engine->pop();
+            throw py::value_error( e.getUserMessage() );
+        }
+
+        std::string exitCode = exitCodeToString( _engine->getExitCode() );
+        Statistics statistics = *_engine->getStatistics();
+        _engine->pop();
+        return std::make_tuple( exitCode, ret, statistics );
+    }
+
+private:
+    std::unique_ptr<Engine> _engine;
+    unsigned _numberOfVariables;
+    bool _feasible;
+};
+
 void saveQuery(InputQuery& inputQuery, std::string filename){
     inputQuery.saveQuery(String(filename));
 }
 
+void saveBinaryQuery(InputQuery& inputQuery, std::string filename){
+    inputQuery.saveBinaryQuery(String(filename));
+}
+
 InputQuery loadQuery(std::string filename){
     return QueryLoader::loadQuery(String(filename));
 }
@@ -475,13 +738,21 @@ PYBIND11_MODULE(MarabouCore, m) {
     m.def("saveQuery", &saveQuery, R"pbdoc(
         Serializes the inputQuery in the given filename
 
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query to be saved
+            filename (str): Name of file to save query
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("filename"));
+    m.def("saveBinaryQuery", &saveBinaryQuery, R"pbdoc(
+        Serializes the inputQuery in the given filename, in the binary query format
+
         Args:
             inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query to be saved
             filename (str): Name of file to save query
         )pbdoc",
         py::arg("inputQuery"), py::arg("filename"));
     m.def("loadQuery", &loadQuery, R"pbdoc(
-        Loads and returns a serialized InputQuery from the given filename
+        Loads and returns a serialized InputQuery (text or binary format) from the given filename
 
         Args:
             filename (str): Name of file to load into an InputQuery
@@ -543,6 +814,98 @@ PYBIND11_MODULE(MarabouCore, m) {
             disjuncts (list of pairs): A list of disjuncts. Each disjunct is represented by a pair: a list of bounds, and a list of (in)equalities.
         )pbdoc",
           py::arg("inputQuery"), py::arg("disjuncts"));
+    m.def("markInputVariables", &markInputVariables, R"pbdoc(
+        Mark variables as the inputs of the network, in order
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query
+            variables (numpy array of int): Input variables, by input index
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("variables"));
+    m.def("markOutputVariables", &markOutputVariables, R"pbdoc(
+        Mark variables as the outputs of the network, in order
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query
+            variables (numpy array of int): Output variables, by output index
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("variables"));
+    m.def("setLowerBounds", &setLowerBounds, R"pbdoc(
+        Set the lower bounds of many variables at once
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query
+            variables (numpy array of int): Variables
+            values (numpy array of float): Lower bounds, one per variable
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("variables"), py::arg("values"));
+    m.def("setUpperBounds", &setUpperBounds, R"pbdoc(
+        Set the upper bounds of many variables at once
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query
+            variables (numpy array of int): Variables
+            values (numpy array of float): Upper bounds, one per variable
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("variables"), py::arg("values"));
+    m.def("addEquations", &addEquations, R"pbdoc(
+        Add many equations at once, given in compressed sparse row form. Equation i
+        is sum(coefficients[j] * variables[j]) <types[i]> scalars[i], for offsets[i] <= j < offsets[i + 1]
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query
+            offsets (numpy array of int): Row offsets, one more than the number of equations
+            variables (numpy array of int): Variables of the addends
+            coefficients (numpy array of float): Coefficients of the addends
+            scalars (numpy array of float): Right hand sides of the equations
+            types (numpy array of int): Types of the equations (EQ, GE or LE)
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("offsets"), py::arg("variables"), py::arg("coefficients"),
+        py::arg("scalars"), py::arg("types"));
+    m.def("addDenseEquations", &addDenseEquations, R"pbdoc(
+        Add the equations of a fully connected layer at once:
+        targetVariables = weights * sourceVariables + biases. Zero weights are skipped.
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query
+            weights (2-D numpy array of float): Weights, one row per target variable
+            sourceVariables (numpy array of int): Input variables of the layer
+            targetVariables (numpy array of int): Output variables of the layer
+            biases (numpy array of float): Biases, one per target variable
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("weights"), py::arg("sourceVariables"),
+        py::arg("targetVariables"), py::arg("biases"));
+    m.def("addReluConstraints", &addReluConstraints, R"pbdoc(
+        Add many Relu constraints at once, fVariables[i] = relu(bVariables[i])
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query
+            bVariables (numpy array of int): Input variables of the Relus
+            fVariables (numpy array of int): Output variables of the Relus
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("bVariables"), py::arg("fVariables"));
+    py::class_<SolverSession>(m, "SolverSession", R"pbdoc(
+        A session for solving many properties of one network. The network is preprocessed once,
+        with the bounds of its query, and each property may only narrow these bounds.
+        )pbdoc")
+        .def(py::init<InputQuery &, MarabouOptions &>(), py::arg("inputQuery"), py::arg("options"))
+        .def("solve", &SolverSession::solve, R"pbdoc(
+            Solve one property of the network
+
+            Args:
+                variables (numpy array of int): Variables to bound, typically the inputs
+                lowerBounds (numpy array of float): Lower bounds of the variables
+                upperBounds (numpy array of float): Upper bounds of the variables
+                equations (list of :class:`~maraboupy.MarabouCore.Equation`): Equations of the property
+
+            Returns:
+                (tuple): tuple containing:
+                    - exitCode (str): A string representing the exit code (sat/unsat/TIMEOUT/ERROR/UNKNOWN/QUIT_REQUESTED).
+                    - vals (Dict[int, float]): Empty dictionary if UNSAT, otherwise a dictionary of SATisfying values for variables
+                    - stats (:class:`~maraboupy.MarabouCore.Statistics`): A Statistics object to how Marabou performed
+            )pbdoc",
+            py::arg("variables"), py::arg("lowerBounds"), py::arg("upperBounds"),
+            py::arg("equations") = std::vector<Equation>());
     py::class_<InputQuery>(m, "InputQuery")
         .def(py::init())
         .def("setUpperBound", &InputQuery::setUpperBound)
@@ -552,6 +915,24 @@ PYBIND11_MODULE(MarabouCore, m) {
         .def("dump", &InputQuery::dump)
         .def("setNumberOfVariables", &InputQuery::setNumberOfVariables)
         .def("addEquation", &InputQuery::addEquation)
+        .def("getNumberOfEquations", [](const InputQuery &ipq){ return ipq.getEquations().size(); })
+        .def("getSolutionValues", &getSolutionValues, R"pbdoc(
+            Returns the solution as a NumPy array indexed by variable, NaN where a variable has no value
+            )pbdoc")
+        .def("getLowerBounds", &getLowerBounds, R"pbdoc(
+            Returns the lower bounds of all variables as a NumPy array, -inf where none is set
+            )pbdoc")
+        .def("getUpperBounds", &getUpperBounds, R"pbdoc(
+            Returns the upper bounds of all variables as a NumPy array, inf where none is set
+            )pbdoc")
+        .def("getLayerBounds", &getLayerBounds, R"pbdoc(
+            Returns the lower and upper bounds that the network level reasoner holds for a layer,
+            as read-only NumPy views that share memory with the reasoner
+
+            Args:
+                layerIndex (int): Index of the layer
+            )pbdoc",
+            py::arg("layerIndex"))
         .def("getSolutionValue", &InputQuery::getSolutionValue)
         .def("getNumberOfVariables", &InputQuery::getNumberOfVariables)
         .def("getNumInputVariables", &InputQuery::getNumInputVariables)
@@ -559,7 +940,11 @@ PYBIND11_MODULE(MarabouCore, m) {
         .def("inputVariableByIndex", &InputQuery::inputVariableByIndex)
         .def("markInputVariable", &InputQuery::markInputVariable)
         .def("markOutputVariable", &InputQuery::markOutputVariable)
-        .def("outputVariableByIndex", &InputQuery::outputVariableByIndex);
+        .def("outputVariableByIndex", &InputQuery::outputVariableByIndex)
+        .def("constructNetworkLevelReasoner", &InputQuery::constructNetworkLevelReasoner, R"pbdoc(
+            Recover the network topology from the equations and constraints, and attach it
+            to the query as its network level reasoner. Returns whether this succeeded.
+            )pbdoc");
     py::enum_<PiecewiseLinearFunctionType>(m, "PiecewiseLinearFunctionType")
         .value("ReLU", PiecewiseLinearFunctionType::RELU)
         .value("AbsoluteValue", PiecewiseLinearFunctionType::ABSOLUTE_VALUE)
@@ -223,37 +223,25 @@ class MarabouNetwork:
         ipq = MarabouCore.InputQuery()
         ipq.setNumberOfVariables(self.numVars)
 
-        i = 0
-        for inputVarArray in self.inputVars:
-            for inputVar in inputVarArray.flatten():
-                ipq.markInputVariable(inputVar, i)
-                i+=1
-
-        i = 0
-        for outputVarArray in self.outputVars:
-            for outputVar in outputVarArray.flatten():
-                ipq.markOutputVariable(outputVar, i)
-                i+=1
-
-        for e in self.equList:
-            eq = MarabouCore.Equation(e.EquationType)
-            for (c, v) in e.addendList:
-                assert v < self.numVars
-                eq.addAddend(c, v)
-            eq.setScalar(e.scalar)
-            ipq.addEquation(eq)
-
-        for e in self.additionalEquList:
-            eq = MarabouCore.Equation(e.EquationType)
-            for (c, v) in e.addendList:
-                assert v < self.numVars
-                eq.addAddend(c, v)
-            eq.setScalar(e.scalar)
-            ipq.addEquation(eq)
-
-        for r in self.reluList:
-            assert r[1] < self.numVars and r[0] < self.numVars
-            MarabouCore.addReluConstraint(ipq, r[0], r[1])
+        # Variables, equations, Relus and bounds are passed to Marabou in bulk,
+        # as NumPy arrays, rather than with one call per element
+        inputVars = [np.array(v).flatten() for v in self.inputVars]
+        MarabouCore.markInputVariables(ipq, np.concatenate(inputVars) if inputVars else [])
+        outputVars = [np.array(v).flatten() for v in self.outputVars]
+        MarabouCore.markOutputVariables(ipq, np.concatenate(outputVars) if outputVars else [])
+
+        equations = self.equList + self.additionalEquList
+        offsets = np.zeros(len(equations) + 1, dtype=np.uint32)
+        offsets[1:] = np.cumsum([len(e.addendList) for e in equations])
+        addends = [addend for e in equations for addend in e.addendList]
+        coefficients = np.array([c for (c, v) in addends], dtype=np.float64)
+        variables = np.array([v for (c, v) in addends], dtype=np.uint32)
+        scalars = np.array([e.scalar for e in equations], dtype=np.float64)
+        types = np.array([int(e.EquationType) for e in equations], dtype=np.int32)
+        MarabouCore.addEquations(ipq, offsets, variables, coefficients, scalars, types)
+
+        relus = np.array(self.reluList, dtype=np.uint32).reshape(-1, 2)
+        MarabouCore.addReluConstraints(ipq, relus[:, 0], relus[:, 1])
 
         for r in self.sigmoidList:
             assert r[1] < self.numVars and r[0] < self.numVars
@@ -274,14 +262,11 @@ class MarabouNetwork:
         for disjunction in self.disjunctionList:
             MarabouCore.addDisjunctionConstraint(ipq, disjunction)
 
-        for l in self.lowerBounds:
-            assert l < self.numVars
-            ipq.setLowerBound(l, self.lowerBounds[l])
+        MarabouCore.setLowerBounds(ipq, np.array(list(self.lowerBounds.keys()), dtype=np.uint32),
+                                   np.array(list(self.lowerBounds.values()), dtype=np.float64))
+        MarabouCore.setUpperBounds(ipq, np.array(list(self.upperBounds.keys()), dtype=np.uint32),
+                                   np.array(list(self.upperBounds.values()), dtype=np.float64))
 
-        for u in self.upperBounds:
-            assert u < self.numVars
-            ipq.setUpperBound(u, self.upperBounds[u])
-            
         return ipq
 
     def solve(self, filename="", verbose=True, options=None):
@@ -315,6 +300,23 @@ class MarabouNetwork:
 
         return [exitCode, vals, stats]
 
+    def createSession(self, options=None):
+        """Function to create a session for solving many properties of this network
+
+        The network is preprocessed once, with its current bounds and equations, and each call to
+        :meth:`~maraboupy.MarabouCore.SolverSession.solve` only adds the bounds and equations of one
+        property. The bounds of a property must lie within the current bounds of the network.
+
+        Args:
+            options (:class:`~maraboupy.MarabouCore.Options`): Object for specifying Marabou options, defaults to None
+
+        Returns:
+            :class:`~maraboupy.MarabouCore.SolverSession`
+        """
+        if options == None:
+            options = MarabouCore.Options()
+        return MarabouCore.SolverSession(self.getMarabouQuery(), options)
+
     def evaluateLocalRobustness(self, input, epsilon, originalClass, verbose=True, options=None, targetClass=None):
         """Function evaluating a specific input is a local robustness within the scope of epslion
 
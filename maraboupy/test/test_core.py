@@ -3,6 +3,7 @@ import warnings
 warnings.filterwarnings('ignore', category = DeprecationWarning)
 warnings.filterwarnings('ignore', category = PendingDeprecationWarning)
 
+import numpy as np
 import pytest
 from maraboupy import MarabouCore
 from maraboupy.Marabou import createOptions
@@ -57,6 +58,58 @@ def test_dump_query():
     assert ipq.getLowerBound(2) > -LARGE
     assert ipq.getUpperBound(2) < LARGE
 
+def test_bulk_query_construction():
+    """
+    This function tests that a query built with the bulk NumPy APIs is solved the same way
+    as the one built element by element, and that invalid arrays are rejected.
+    """
+    for property_bound, expected in [(-2.0, "unsat"), (3.0, "sat")]:
+        ipq = define_bulk_ipq(property_bound)
+        assert ipq.getLowerBound(0) == -1 and ipq.getUpperBound(1) == LARGE
+        assert ipq.inputVariableByIndex(0) == 0 and ipq.outputVariableByIndex(0) == 2
+        assert ipq.getNumberOfEquations() == 2
+        exitCode, vals, stats = MarabouCore.solve(ipq, OPT)
+        assert exitCode == expected
+
+    ipq = MarabouCore.InputQuery()
+    ipq.setNumberOfVariables(3)
+    with pytest.raises(ValueError):
+        MarabouCore.setLowerBounds(ipq, np.array([0, 3]), np.array([0.0, 0.0]))
+    with pytest.raises(ValueError):
+        MarabouCore.setUpperBounds(ipq, np.array([0, 1]), np.array([0.0]))
+    with pytest.raises(ValueError):
+        MarabouCore.addReluConstraints(ipq, np.array([0]), np.array([1, 2]))
+    with pytest.raises(ValueError):
+        MarabouCore.addEquations(ipq, np.array([0, 2]), np.array([0, 1]), np.array([1.0, 1.0]),
+                                 np.array([0.0]), np.array([3]))
+    with pytest.raises(ValueError):
+        MarabouCore.addDenseEquations(ipq, np.ones((2, 2)), np.array([0, 1]), np.array([2]),
+                                      np.zeros(2))
+
+    # A dense layer skips zero weights: 2 * x0 + 1 = x2
+    MarabouCore.addDenseEquations(ipq, np.array([[2.0, 0.0]]), np.array([0, 1]), np.array([2]),
+                                  np.array([1.0]))
+    assert ipq.getNumberOfEquations() == 1
+
+def test_array_access():
+    """
+    This function tests that solutions and bounds can be read from a query as NumPy arrays
+    """
+    ipq = define_ipq(3.0)
+    assert list(ipq.getLowerBounds()) == [-1, 0, -LARGE]
+    upper = ipq.getUpperBounds()
+    assert upper[0] == 1 and upper[1] == LARGE and np.isinf(upper[2])
+
+    # There is no solution before solving
+    assert np.isnan(ipq.getSolutionValues()).all()
+
+    exitCode, vals, stats = MarabouCore.solve(ipq, OPT)
+    assert exitCode == "sat"
+    solution = ipq.getSolutionValues()
+    assert solution.shape == (3,)
+    for var in vals:
+        assert solution[var] == vals[var]
+
 def define_ipq(property_bound):
     """
     This function defines a simple input query directly through MarabouCore
@@ -96,3 +149,30 @@ def define_ipq(property_bound):
     property_eq.setScalar(property_bound)
     ipq.addEquation(property_eq)
     return ipq
+
+def define_bulk_ipq(property_bound):
+    """
+    This function defines the query of define_ipq with the bulk NumPy APIs of MarabouCore
+    Arguments:
+        property_bound: (float) value of upper bound for x + y
+    Returns:
+        ipq (MarabouCore.InputQuery) input query object representing network and constraints
+    """
+    ipq = MarabouCore.InputQuery()
+    ipq.setNumberOfVariables(3)
+
+    MarabouCore.markInputVariables(ipq, np.array([0]))
+    MarabouCore.markOutputVariables(ipq, np.array([2]))
+    MarabouCore.setLowerBounds(ipq, np.array([0, 1, 2]), np.array([-1, 0, -LARGE]))
+    MarabouCore.setUpperBounds(ipq, np.array([0, 1]), np.array([1, LARGE]))
+    MarabouCore.addReluConstraints(ipq, np.array([0]), np.array([1]))
+
+    # y - relu(x) = 0 and x + y <= property_bound, in compressed sparse row form
+    MarabouCore.addEquations(ipq,
+                             offsets = np.array([0, 2, 4]),
+                             variables = np.array([2, 1, 0, 2]),
+                             coefficients = np.array([1, -1, 1, 1]),
+                             scalars = np.array([0, property_bound]),
+                             types = np.array([int(MarabouCore.Equation.EQ),
+                                               int(MarabouCore.Equation.LE)]))
+    return ipq
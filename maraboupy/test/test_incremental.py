@@ -65,3 +65,53 @@ def test_incremental():
 
     for i in range(len(result_inc)):
         assert(result_noninc[i] == result_inc[i])
+
+def test_session():
+    """
+    Test that solving the properties in one solver session gives the same results as solving them one
+    by one
+    """
+    filename = os.path.join(os.path.dirname(__file__), ONNX_FILE)
+    random_images = [np.random.random((784,1)) for _ in range(NUM_SAMPLES)]
+
+    network = Marabou.read_onnx(filename)
+    inputVars = np.array(network.inputVars[0]).flatten()
+    outputVars = network.outputVars[0].flatten()
+
+    # The bounds of the network contain those of all properties
+    for x in inputVars:
+        network.setLowerBound(x, 0)
+        network.setUpperBound(x, 1)
+    session = network.createSession(OPT)
+
+    equations = []
+    for outputIndex in range(len(outputVars)):
+        if outputIndex != LABEL:
+            equation = MarabouCore.Equation(MarabouCore.Equation.LE)
+            equation.addAddend(1, outputVars[outputIndex])
+            equation.addAddend(-1, outputVars[LABEL])
+            equation.setScalar(0)
+            equations.append(equation)
+
+    for img in random_images:
+        lowerBounds = np.maximum(0, img.flatten() - EPSILON)
+        upperBounds = np.minimum(1, img.flatten() + EPSILON)
+        res, vals, _ = session.solve(inputVars, lowerBounds, upperBounds, equations)
+
+        for i, x in enumerate(inputVars):
+            network.setLowerBound(x, lowerBounds[i])
+            network.setUpperBound(x, upperBounds[i])
+        network.additionalEquList.clear()
+        for outputIndex in range(len(outputVars)):
+            if outputIndex != LABEL:
+                network.addInequality([outputVars[outputIndex], outputVars[LABEL]], [1, -1], 0,
+                                      isProperty=True)
+        expected, _, _ = network.solve(verbose=False, options=OPT)
+        assert res == expected
+        if res == "sat":
+            for i, x in enumerate(inputVars):
+                assert lowerBounds[i] - 1e-6 <= vals[x] <= upperBounds[i] + 1e-6
+
+    # Variables that are not in the network are rejected
+    with pytest.raises(ValueError):
+        session.solve(np.array([network.numVars]), np.zeros(1), np.ones(1))
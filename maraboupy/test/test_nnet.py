@@ -135,6 +135,24 @@ def test_evaluateUNSAT():
     marabouEval = network.evaluateWithMarabou([testInput], options=OPT, filename="")
     assert marabouEval is None
 
+def test_layer_bounds():
+    """
+    Test that the bounds of the network level reasoner are exposed as read-only NumPy views
+    """
+    filename = os.path.join(os.path.dirname(__file__), NETWORK_FOLDER, "fc_2-2-3.nnet")
+    network = Marabou.read_nnet(filename)
+    ipq = network.getMarabouQuery()
+    with pytest.raises(ValueError):
+        ipq.getLayerBounds(0)
+
+    assert ipq.constructNetworkLevelReasoner()
+    lbs, ubs = ipq.getLayerBounds(0)
+    assert lbs.shape == (2,) and ubs.shape == (2,)
+    with pytest.raises(ValueError):
+        lbs[0] = 0
+    with pytest.raises(IndexError):
+        ipq.getLayerBounds(100)
+
 def evaluateFile(filename, testInputs, testOutputs, normalize = False, normInput = False, denormOutput = False):
     """
     Load network and evaluate testInputs with and without Marabou
@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file MappedFile.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Memory-maps a file read-only, or reads it into a buffer on platforms
+ ** without mmap.
+
+ **/
+
+#include "CommonError.h"
+#include "MappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+MappedFile::MappedFile( const String &path )
+    : _data( NULL )
+    , _size( 0 )
+    , _mapped( false )
+{
+#ifndef _WIN32
+    int descriptor = ::open( path.ascii(), O_RDONLY );
+    if ( descriptor < 0 )
+        throw CommonError( CommonError::OPEN_FAILED, path.ascii() );
+
+    struct stat fileStat;
+    if ( fstat( descriptor, &fileStat ) != 0 )
+    {
+        ::close( descriptor );
+        throw CommonError( CommonError::STAT_FAILED, path.ascii() );
+    }
+    _size = fileStat.st_size;
+
+    // Empty files cannot be mapped
+    if ( _size > 0 )
+    {
+        void *mapping = mmap( NULL, _size, PROT_READ, MAP_PRIVATE, descriptor, 0 );
+        if ( mapping == MAP_FAILED )
+        {
+            ::close( descriptor );
+            throw CommonError( CommonError::READ_FAILED, path.ascii() );
+        }
+
+        // The file is parsed front to back
+        madvise( mapping, _size, MADV_SEQUENTIAL );
+
+        _data = (const char *)mapping;
+        _mapped = true;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close( descriptor );
+#else
+    std::ifstream file( path.ascii(), std::ios::binary | std::ios::ate );
+    if ( !file )
+        throw CommonError( CommonError::OPEN_FAILED, path.ascii() );
+
+    _size = file.tellg();
+    _buffer.resize( _size );
+    file.seekg( 0 );
+    if ( !file.read( _buffer.data(), _size ) )
+        throw CommonError( CommonError::READ_FAILED, path.ascii() );
+    _data = _buffer.data();
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+    if ( _mapped )
+        munmap( (void *)_data, _size );
+#endif
+}
+
+const char *MappedFile::data() const
+{
+    return _data;
+}
+
+unsigned long long MappedFile::size() const
+{
+    return _size;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,59 @@
+/*********************                                                        */
+/*! \file MappedFile.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A read-only view of the contents of a file. The file is memory-mapped
+ ** where the platform supports it, so that large files can be parsed
+ ** without being copied into a buffer first; otherwise it is read into
+ ** memory.
+
+ **/
+
+#ifndef __MappedFile_h__
+#define __MappedFile_h__
+
+#include "MString.h"
+
+#include <vector>
+
+class MappedFile
+{
+public:
+    /*
+      Map the file at the given path. Throws a CommonError if the file
+      cannot be opened or mapped.
+    */
+    MappedFile( const String &path );
+    ~MappedFile();
+
+    const char *data() const;
+    unsigned long long size() const;
+
+private:
+    const char *_data;
+    unsigned long long _size;
+
+    /*
+      Whether _data is a memory mapping, or points into _buffer
+    */
+    bool _mapped;
+    std::vector<char> _buffer;
+
+    MappedFile( const MappedFile & ) = delete;
+    MappedFile &operator=( const MappedFile & ) = delete;
+};
+
+#endif // __MappedFile_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -39,6 +39,9 @@ Statistics::Statistics()
     _unsignedAttributes[PP_NUM_CONSTRAINTS_REMOVED] = 0;
     _unsignedAttributes[PP_NUM_EQUATIONS_REMOVED] = 0;
     _unsignedAttributes[TOTAL_NUMBER_OF_VALID_CASE_SPLITS] = 0;
+    _unsignedAttributes[NUM_SHARED_TIGHTENINGS_PUBLISHED] = 0;
+    _unsignedAttributes[NUM_SHARED_TIGHTENINGS_IMPORTED] = 0;
+    _unsignedAttributes[NUM_DONATED_SUBTREES] = 0;
 
     _longAttributes[NUM_MAIN_LOOP_ITERATIONS] = 0;
     _longAttributes[NUM_SIMPLEX_STEPS] = 0;
@@ -81,6 +84,7 @@ Statistics::Statistics()
     _longAttributes[TOTAL_TIME_UPDATING_SOI_PHASE_PATTERN_MICRO] = 0;
     _longAttributes[NUM_PROPOSED_PHASE_PATTERN_UPDATE] = 0;
     _longAttributes[NUM_ACCEPTED_PHASE_PATTERN_UPDATE] = 0;
+    _longAttributes[NUM_ADOPTED_SHARED_PHASE_PATTERNS] = 0;
     _longAttributes[TOTAL_TIME_OBTAIN_CURRENT_ASSIGNMENT_MICRO] = 0;
     _longAttributes[TOTAL_TIME_LOCAL_SEARCH_MICRO] = 0;
     _longAttributes[TOTAL_TIME_GETTING_SOI_PHASE_PATTERN_MICRO] = 0;
@@ -329,6 +333,11 @@ void Statistics::print()
             , getUnsignedAttribute( Statistics::NUM_POPS ) );
     printf( "\tMax stack depth: %u\n"
             , getUnsignedAttribute( Statistics::MAX_DECISION_LEVEL ) );
+    printf( "\tShared tightenings published: %u. Imported: %u\n"
+            , getUnsignedAttribute( Statistics::NUM_SHARED_TIGHTENINGS_PUBLISHED )
+            , getUnsignedAttribute( Statistics::NUM_SHARED_TIGHTENINGS_IMPORTED ) );
+    printf( "\tSubtrees handed off to other workers: %u\n"
+            , getUnsignedAttribute( Statistics::NUM_DONATED_SUBTREES ) );
 
     printf( "\t--- Bound Tightening Statistics ---\n" );
     printf( "\tNumber of tightened bounds: %llu.\n",
@@ -379,6 +388,8 @@ void Statistics::print()
             , num_accepted_phase_pattern_update
             , printPercents( num_accepted_phase_pattern_update,
                              num_proposed_phase_pattern_update ) );
+    printf( "\tNumber of phase patterns adopted from other threads: %llu\n",
+            getLongAttribute( Statistics::NUM_ADOPTED_SHARED_PHASE_PATTERNS ) );
     unsigned long long totalTimeUpdatingSoIPatternPattern =
         getLongAttribute( Statistics::TOTAL_TIME_UPDATING_SOI_PHASE_PATTERN_MICRO );
     printf( "\tTotal time (%% of local search time) updating SoI phase pattern : %llu milli [%.2lf%%]\n"
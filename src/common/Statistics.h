@@ -67,6 +67,14 @@ public:
      // Total number of valid case splits performed so far (including in other
      // branches of the search tree, that have since been popped)
      TOTAL_NUMBER_OF_VALID_CASE_SPLITS,
+
+     // Number of level-0 tightenings published to / imported from the other
+     // DnC workers
+     NUM_SHARED_TIGHTENINGS_PUBLISHED,
+     NUM_SHARED_TIGHTENINGS_IMPORTED,
+
+     // Number of unexplored subtrees handed off to other DnC workers
+     NUM_DONATED_SUBTREES,
     };
 
     enum StatisticsLongAttribute
@@ -189,6 +197,10 @@ public:
      NUM_PROPOSED_PHASE_PATTERN_UPDATE,
      NUM_ACCEPTED_PHASE_PATTERN_UPDATE,
 
+     // Number of times a phase pattern found by another parallel DeepSoI
+     // thread was adopted.
+     NUM_ADOPTED_SHARED_PHASE_PATTERNS,
+
      // Total time obtaining the current variable assignment from the tableau.
      TOTAL_TIME_OBTAIN_CURRENT_ASSIGNMENT_MICRO,
 
@@ -28,6 +28,10 @@ const bool GlobalConfiguration::USE_DEEPSOI_LOCAL_SEARCH = true;
 
 const double GlobalConfiguration::SCORE_BUMP_FOR_PL_CONSTRAINTS_NOT_IN_SOI = 5;
 
+const unsigned GlobalConfiguration::DEEP_SOI_SHARING_INTERVAL = 20;
+
+const double GlobalConfiguration::DEEP_SOI_SHARED_SCORE_WEIGHT = 0.5;
+
 // Use the polarity metrics to decide which branch to take first in a case split
 // and how to repair a ReLU constraint.
 const bool GlobalConfiguration::USE_POLARITY_BASED_DIRECTION_HEURISTICS = true;
@@ -99,6 +103,8 @@ const unsigned GlobalConfiguration::POLARITY_CANDIDATES_THRESHOLD = 5;
 
 const unsigned GlobalConfiguration::DNC_DEPTH_THRESHOLD = 5;
 
+const unsigned GlobalConfiguration::DNC_SHARED_TIGHTENINGS_CAPACITY = 65536;
+
 #ifdef ENABLE_GUROBI
 const unsigned GlobalConfiguration::GUROBI_NUMBER_OF_THREADS = 1;
 const bool GlobalConfiguration::GUROBI_LOGGING = false;
@@ -36,6 +36,15 @@ public:
     // order.
     static const double SCORE_BUMP_FOR_PL_CONSTRAINTS_NOT_IN_SOI;
 
+    // In parallel DeepSoI, the number of phase pattern proposals a thread makes
+    // between exchanging its phase pattern and pseudo-impact scores with
+    // the other threads.
+    static const unsigned DEEP_SOI_SHARING_INTERVAL;
+
+    // In parallel DeepSoI, the weight of the average pseudo-impact score over
+    // all threads when it is blended into a thread's own score.
+    static const double DEEP_SOI_SHARED_SCORE_WEIGHT;
+
     // Use the polarity metrics to decide which branch to take first in a case split
     // and how to repair a ReLU constraint.
     static const bool USE_POLARITY_BASED_DIRECTION_HEURISTICS;
@@ -232,6 +241,11 @@ public:
     */
     static const unsigned DNC_DEPTH_THRESHOLD;
 
+    /* The max number of level-0 tightenings that DnC workers can share with
+       each other. Tightenings published once the channel is full are dropped.
+    */
+    static const unsigned DNC_SHARED_TIGHTENINGS_CAPACITY;
+
 #ifdef ENABLE_GUROBI
     /*
       The number of threads Gurobi spawns
@@ -94,6 +94,15 @@ void OptionParser::initialize()
         ( "summary-file",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::SUMMARY_FILE]) )->default_value( (*_stringOptions)[Options::SUMMARY_FILE] ),
           "Produce a summary file of the run." )
+        ( "checkpoint-file",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::CHECKPOINT_FILE]) )->default_value( (*_stringOptions)[Options::CHECKPOINT_FILE] ),
+          "Periodically write the unsolved part of the search to this file." )
+        ( "checkpoint-interval",
+          boost::program_options::value<int>( &((*_intOptions)[Options::CHECKPOINT_INTERVAL]) )->default_value( (*_intOptions)[Options::CHECKPOINT_INTERVAL] ),
+          "The number of seconds between two checkpoints." )
+        ( "resume",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::RESUME_FILE]) )->default_value( (*_stringOptions)[Options::RESUME_FILE] ),
+          "Resume the search from a checkpoint file. The network, property and options must be those of the run that wrote it." )
         ( "export-assignment",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::EXPORT_ASSIGNMENT]) )->default_value( (*_boolOptions)[Options::EXPORT_ASSIGNMENT] ),
           "Export a satisfying assignment if found." )
@@ -148,6 +157,12 @@ void OptionParser::initialize()
         ( "restore-tree-states",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::RESTORE_TREE_STATES]) )->default_value( (*_boolOptions)[Options::RESTORE_TREE_STATES] ),
           "(SnC) Restore tree states in SnC mode.\n" )
+        ( "tree-parallel",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::TREE_PARALLEL]) )->default_value( (*_boolOptions)[Options::TREE_PARALLEL] ),
+          "(SnC) Let busy workers hand off unexplored case-split subtrees to idle workers. Requires --snc, and turns off parallel DeepSoI." )
+        ( "thread-placement",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::THREAD_PLACEMENT]) )->default_value( (*_stringOptions)[Options::THREAD_PLACEMENT] ),
+          "(SnC) Pinning of worker threads to cores: none/compact/scatter. compact fills one NUMA node before the next, scatter alternates between nodes. default: none." )
         ( "blas-threads",
           boost::program_options::value<int>( &((*_intOptions)[Options::NUM_BLAS_THREADS]) )->default_value( (*_intOptions)[Options::NUM_BLAS_THREADS] ),
           "Number of threads to use for matrix multiplication with OpenBLAS." )
@@ -208,7 +223,7 @@ int OptionParser::extractIntValue( const String &option )
 
 void OptionParser::printHelpMessage() const
 {
-    std::cerr << "\nusage: ./Marabou <network.nnet> <property> [<options>]\n" << std::endl;
+    std::cerr << "\nusage: ./Marabou <network.nnet|network.onnx> <property> [<options>]\n" << std::endl;
     std::cerr <<  "OR     ./Marabou --input-query <input-query-file> [<options>]\n" << std::endl;
 
     std::cerr << "You might also consider using the ./resources/runMarabou.py "
@@ -49,6 +49,7 @@ void Options::initializeDefaultValues()
     _boolOptions[SOLVE_WITH_MILP] = false;
     _boolOptions[PERFORM_LP_TIGHTENING_AFTER_SPLIT] = false;
     _boolOptions[NO_PARALLEL_DEEPSOI] = false;
+    _boolOptions[TREE_PARALLEL] = false;
     _boolOptions[EXPORT_ASSIGNMENT] = false;
     _boolOptions[DEBUG_ASSIGNMENT] = false;
 
@@ -66,6 +67,7 @@ void Options::initializeDefaultValues()
     _intOptions[NUMBER_OF_SIMULATIONS] = 100;
     _intOptions[SEED] = 1;
     _intOptions[NUM_BLAS_THREADS] = 1;
+    _intOptions[CHECKPOINT_INTERVAL] = 600;
 
     /*
       Float options
@@ -93,6 +95,9 @@ void Options::initializeDefaultValues()
     _stringOptions[SOI_SEARCH_STRATEGY] = "mcmc";
     _stringOptions[SOI_INITIALIZATION_STRATEGY] = "input-assignment";
     _stringOptions[LP_SOLVER] = gurobiEnabled() ? "gurobi" : "native";
+    _stringOptions[THREAD_PLACEMENT] = "none";
+    _stringOptions[CHECKPOINT_FILE] = "";
+    _stringOptions[RESUME_FILE] = "";
 }
 
 void Options::parseOptions( int argc, char **argv )
@@ -249,3 +254,15 @@ LPSolverType Options::getLPSolverType() const
     else
         return gurobiEnabled() ? LPSolverType::GUROBI : LPSolverType::NATIVE;
 }
+
+ThreadPlacementPolicy Options::getThreadPlacementPolicy() const
+{
+    String policyString = String( _stringOptions.get
+                                  ( Options::THREAD_PLACEMENT ) );
+    if ( policyString == "compact" )
+        return ThreadPlacementPolicy::Compact;
+    else if ( policyString == "scatter" )
+        return ThreadPlacementPolicy::Scatter;
+    else
+        return ThreadPlacementPolicy::None;
+}
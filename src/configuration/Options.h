@@ -26,6 +26,7 @@
 #include "SoIInitializationStrategy.h"
 #include "SoISearchStrategy.h"
 #include "SymbolicBoundTighteningType.h"
+#include "ThreadPlacementPolicy.h"
 
 #include "boost/program_options.hpp"
 
@@ -65,6 +66,10 @@ public:
         // any of the thread finishes.
         NO_PARALLEL_DEEPSOI,
 
+        // In SnC mode, let busy workers hand off the unexplored alternatives of
+        // their case splits to idle workers.
+        TREE_PARALLEL,
+
         // Export SAT assignment into a file, use EXPORT_ASSIGNMENT_FILE to specify the file (default: assignment.txt)
         EXPORT_ASSIGNMENT,
 
@@ -99,6 +104,9 @@ public:
 
         // The number of threads to use for OpenBLAS matrix multiplication.
         NUM_BLAS_THREADS,
+
+        // The number of seconds between two checkpoints
+        CHECKPOINT_INTERVAL,
     };
 
     enum FloatOptions{
@@ -136,6 +144,13 @@ public:
         // The procedure/solver for solving the LP
         LP_SOLVER,
 
+        // How to place the DnC worker threads on cores: none/compact/scatter
+        THREAD_PLACEMENT,
+
+        // Periodically write the unsolved part of the search to this file
+        CHECKPOINT_FILE,
+        // Resume the search from a checkpoint written by an earlier run
+        RESUME_FILE,
     };
 
     /*
@@ -167,6 +182,7 @@ public:
     SoIInitializationStrategy getSoIInitializationStrategy() const;
     SoISearchStrategy getSoISearchStrategy() const;
     LPSolverType getLPSolverType() const;
+    ThreadPlacementPolicy getThreadPlacementPolicy() const;
 
     /*
       Retrieve the value of the various options, by type
@@ -32,6 +32,15 @@ AbsoluteValueConstraint::AbsoluteValueConstraint( unsigned b, unsigned f )
 {
 }
 
+AbsoluteValueConstraint::AbsoluteValueConstraint( unsigned b, unsigned f,
+                                                  unsigned posAux, unsigned negAux )
+    : AbsoluteValueConstraint( b, f )
+{
+    _posAux = posAux;
+    _negAux = negAux;
+    _auxVarsInUse = true;
+}
+
 AbsoluteValueConstraint::AbsoluteValueConstraint( const String &serializedAbs )
     : _auxVarsInUse( false )
     , _haveEliminatedVariables( false )
@@ -41,6 +41,12 @@ public:
       f = | b |
     */
     AbsoluteValueConstraint( unsigned b, unsigned f );
+
+    /*
+      A constraint that already uses the auxiliary variables of its
+      positive and negative phases
+    */
+    AbsoluteValueConstraint( unsigned b, unsigned f, unsigned posAux, unsigned negAux );
     AbsoluteValueConstraint( const String &serializedAbs );
 
     /*
@@ -0,0 +1,148 @@
+/*********************                                                        */
+/*! \file BinaryQueryFormat.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The binary input query format, written by InputQuery::saveBinaryQuery
+ ** and read by QueryLoader. A file consists of a header followed by flat
+ ** arrays, each starting at an 8-byte aligned offset, in this order:
+ **
+ **   uint32 inputVariables[numInputVariables]     (by input index)
+ **   uint32 outputVariables[numOutputVariables]   (by output index)
+ **   uint32 lowerBoundVariables[numLowerBounds]
+ **   double lowerBoundValues[numLowerBounds]
+ **   uint32 upperBoundVariables[numUpperBounds]
+ **   double upperBoundValues[numUpperBounds]
+ **   uint32 equationTypes[numEquations]
+ **   double equationScalars[numEquations]
+ **   uint32 equationOffsets[numEquations + 1]     (CSR row offsets)
+ **   uint32 addendVariables[numAddends]
+ **   double addendCoefficients[numAddends]
+ **   constraint records[numConstraints]
+ **
+ ** Each constraint is a fixed-width ConstraintRecord that holds its type
+ ** and variable indices. Max constraints append their elements as a uint32
+ ** array, and disjunctions append one DisjunctRecord per disjunct, each
+ ** followed by its BoundRecords and EquationRecords (an EquationRecord is
+ ** followed by its AddendRecords). All records are multiples of 8 bytes,
+ ** so they stay aligned. Numbers are stored in the byte order of the
+ ** machine that wrote the file; the header's byte order mark lets readers
+ ** reject files from other machines.
+
+**/
+
+#ifndef __BinaryQueryFormat_h__
+#define __BinaryQueryFormat_h__
+
+#include "MString.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace BinaryQueryFormat
+{
+    static const char MAGIC[8] = { 'M', 'A', 'R', 'A', 'B', 'O', 'U', 'Q' };
+    static const uint32_t VERSION = 2;
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    /*
+      Files with this extension are dumped in the binary format
+    */
+    static const char *const FILE_EXTENSION = ".mbq";
+
+    struct Header
+    {
+        char _magic[8];
+        uint32_t _version;
+        uint32_t _byteOrderMark;
+        uint32_t _numberOfVariables;
+        uint32_t _numInputVariables;
+        uint32_t _numOutputVariables;
+        uint32_t _numLowerBounds;
+        uint32_t _numUpperBounds;
+        uint32_t _numEquations;
+        uint32_t _numAddends;
+        uint32_t _numConstraints;
+    };
+
+    enum ConstraintType {
+        RELU_CONSTRAINT = 0,
+        MAX_CONSTRAINT = 1,
+        ABSOLUTE_VALUE_CONSTRAINT = 2,
+        SIGN_CONSTRAINT = 3,
+        DISJUNCTION_CONSTRAINT = 4,
+        SIGMOID_CONSTRAINT = 5,
+    };
+
+    struct ConstraintRecord
+    {
+        // A ConstraintType
+        uint32_t _type;
+        uint32_t _b;
+        uint32_t _f;
+        // The number of auxiliary variables in use, at most 2
+        uint32_t _numAuxVariables;
+        uint32_t _aux[2];
+        // The number of elements of a Max, or of disjuncts of a disjunction
+        uint32_t _numElements;
+        // Whether a Max has eliminated phases, whose maximal value follows
+        uint32_t _haveEliminatedPhases;
+        double _maxValueOfEliminatedPhases;
+    };
+
+    struct DisjunctRecord
+    {
+        uint32_t _numBounds;
+        uint32_t _numEquations;
+    };
+
+    struct BoundRecord
+    {
+        uint32_t _variable;
+        // A Tightening::BoundType
+        uint32_t _type;
+        double _value;
+    };
+
+    struct EquationRecord
+    {
+        // An Equation::EquationType
+        uint32_t _type;
+        uint32_t _numAddends;
+        double _scalar;
+    };
+
+    struct AddendRecord
+    {
+        uint32_t _variable;
+        uint32_t _padding;
+        double _coefficient;
+    };
+
+    inline unsigned long long alignedSize( unsigned long long size )
+    {
+        return ( size + 7 ) & ~7ULL;
+    }
+
+    inline bool hasBinaryExtension( const String &fileName )
+    {
+        unsigned extensionLength = strlen( FILE_EXTENSION );
+        return fileName.length() >= extensionLength &&
+            fileName.substring( fileName.length() - extensionLength,
+                                extensionLength ) == FILE_EXTENSION;
+    }
+}
+
+#endif // __BinaryQueryFormat_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
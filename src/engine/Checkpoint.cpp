@@ -0,0 +1,296 @@
+/*********************                                                        */
+/*! \file Checkpoint.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Checkpoints are plain text, with doubles printed at full precision,
+ ** and are replaced atomically by renaming a temporary file.
+
+**/
+
+#include "AutoFile.h"
+#include "Checkpoint.h"
+#include "CommonError.h"
+#include "Debug.h"
+#include "File.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "Options.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+/*
+  File format, one item per line:
+
+    marabou-checkpoint,2
+    <fingerprint>
+    <number of global tightenings>
+    <var>,<l|u>,<value>                       (for each global tightening)
+    <number of regions>
+    <number of tightenings>,<number of equations>  (for each region, followed by)
+    <var>,<l|u>,<value>                       (for each tightening)
+    <type>,<scalar>,<var>,<coefficient>,...   (for each equation)
+
+  Values are printed with full precision, so that regions read back are
+  exactly the ones that were written.
+*/
+static const char *CHECKPOINT_HEADER = "marabou-checkpoint,2";
+
+/*
+  64-bit FNV-1a, over the exact bytes of the hashed values
+*/
+class FingerprintHasher
+{
+public:
+    FingerprintHasher()
+        : _hash( 14695981039346656037ULL )
+    {
+    }
+
+    void add( const void *data, unsigned size )
+    {
+        const unsigned char *bytes = (const unsigned char *)data;
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            _hash ^= bytes[i];
+            _hash *= 1099511628211ULL;
+        }
+    }
+
+    void add( unsigned value )
+    {
+        add( &value, sizeof( value ) );
+    }
+
+    void add( double value )
+    {
+        add( &value, sizeof( value ) );
+    }
+
+    void add( const String &value )
+    {
+        add( value.length() );
+        add( value.ascii(), value.length() );
+    }
+
+    String toString() const
+    {
+        return Stringf( "%016llx", _hash );
+    }
+
+private:
+    unsigned long long _hash;
+};
+
+void Checkpoint::addSubQuery( const String &queryId, const PiecewiseLinearCaseSplit &split )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    _unsolvedSubQueries[queryId] = split;
+}
+
+void Checkpoint::removeSubQuery( const String &queryId )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    if ( _unsolvedSubQueries.exists( queryId ) )
+        _unsolvedSubQueries.erase( queryId );
+}
+
+void Checkpoint::getUnsolvedRegions( List<PiecewiseLinearCaseSplit> &regions ) const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    regions.clear();
+    for ( const auto &entry : _unsolvedSubQueries )
+        regions.append( entry.second );
+}
+
+String Checkpoint::computeFingerprint( const InputQuery &preprocessedQuery )
+{
+    FingerprintHasher hasher;
+
+    hasher.add( preprocessedQuery.getNumberOfVariables() );
+
+    hasher.add( preprocessedQuery.getEquations().size() );
+    for ( const auto &equation : preprocessedQuery.getEquations() )
+    {
+        hasher.add( (unsigned)equation._type );
+        hasher.add( equation._scalar );
+        hasher.add( equation._addends.size() );
+        for ( const auto &addend : equation._addends )
+        {
+            hasher.add( addend._variable );
+            hasher.add( addend._coefficient );
+        }
+    }
+
+    hasher.add( preprocessedQuery.getPiecewiseLinearConstraints().size() );
+    for ( const auto &constraint : preprocessedQuery.getPiecewiseLinearConstraints() )
+        hasher.add( constraint->serializeToString() );
+
+    // Resumed regions are divided again according to these
+    Options *options = Options::get();
+    hasher.add( options->getString( Options::SNC_SPLITTING_STRATEGY ) );
+    hasher.add( (double)options->getFloat( Options::PREPROCESSOR_BOUND_TOLERANCE ) );
+
+    return hasher.toString();
+}
+
+String Checkpoint::tighteningToString( const Tightening &tightening )
+{
+    return Stringf( "%u,%c,%.17g", tightening._variable,
+                    tightening._type == Tightening::LB ? 'l' : 'u',
+                    tightening._value );
+}
+
+Tightening Checkpoint::stringToTightening( const String &line )
+{
+    List<String> tokens = line.tokenize( "," );
+    if ( tokens.size() != 3 )
+        throw MarabouError( MarabouError::INVALID_CHECKPOINT, line.ascii() );
+
+    auto it = tokens.begin();
+    unsigned variable = atoi( it->ascii() );
+    ++it;
+    String type = it->trim();
+    if ( type != "l" && type != "u" )
+        throw MarabouError( MarabouError::INVALID_CHECKPOINT, line.ascii() );
+    ++it;
+    double value = atof( it->ascii() );
+
+    return Tightening( variable, value, type == "l" ? Tightening::LB : Tightening::UB );
+}
+
+void Checkpoint::write( const String &path,
+                        const String &fingerprint,
+                        const List<PiecewiseLinearCaseSplit> &regions,
+                        const List<Tightening> &globalTightenings )
+{
+    String temporaryPath = path + ".tmp";
+    {
+        AutoFile file( temporaryPath );
+        file->open( IFile::MODE_WRITE_TRUNCATE );
+
+        file->write( Stringf( "%s\n", CHECKPOINT_HEADER ) );
+        file->write( fingerprint + "\n" );
+
+        file->write( Stringf( "%u\n", globalTightenings.size() ) );
+        for ( const auto &tightening : globalTightenings )
+            file->write( tighteningToString( tightening ) + "\n" );
+
+        file->write( Stringf( "%u\n", regions.size() ) );
+        for ( const auto &region : regions )
+        {
+            const List<Tightening> &bounds = region.getBoundTightenings();
+            const List<Equation> &equations = region.getEquations();
+            file->write( Stringf( "%u,%u\n", bounds.size(), equations.size() ) );
+
+            for ( const auto &tightening : bounds )
+                file->write( tighteningToString( tightening ) + "\n" );
+
+            for ( const auto &equation : equations )
+            {
+                String line = Stringf( "%d,%.17g", equation._type, equation._scalar );
+                for ( const auto &addend : equation._addends )
+                    line += Stringf( ",%u,%.17g", addend._variable, addend._coefficient );
+                file->write( line + "\n" );
+            }
+        }
+    }
+
+    if ( std::rename( temporaryPath.ascii(), path.ascii() ) != 0 )
+        throw CommonError( CommonError::WRITE_FAILED, path.ascii() );
+}
+
+void Checkpoint::read( const String &path,
+                       const String &fingerprint,
+                       List<PiecewiseLinearCaseSplit> &regions,
+                       List<Tightening> &globalTightenings )
+{
+    if ( !File::exists( path ) )
+        throw MarabouError( MarabouError::FILE_DOESNT_EXIST, path.ascii() );
+
+    regions.clear();
+    globalTightenings.clear();
+
+    AutoFile file( path );
+    file->open( IFile::MODE_READ );
+
+    try
+    {
+        if ( file->readLine().trim() != CHECKPOINT_HEADER )
+            throw MarabouError( MarabouError::INVALID_CHECKPOINT, path.ascii() );
+
+        if ( file->readLine().trim() != fingerprint )
+            throw MarabouError( MarabouError::CHECKPOINT_MISMATCH,
+                                Stringf( "%s was written for another query or other "
+                                         "options", path.ascii() ).ascii() );
+
+        unsigned numGlobalTightenings = atoi( file->readLine().ascii() );
+        for ( unsigned i = 0; i < numGlobalTightenings; ++i )
+            globalTightenings.append( stringToTightening( file->readLine() ) );
+
+        unsigned numRegions = atoi( file->readLine().ascii() );
+        for ( unsigned i = 0; i < numRegions; ++i )
+        {
+            String line = file->readLine();
+            List<String> counts = line.tokenize( "," );
+            if ( counts.size() != 2 )
+                throw MarabouError( MarabouError::INVALID_CHECKPOINT, line.ascii() );
+            unsigned numBounds = atoi( counts.front().ascii() );
+            unsigned numEquations = atoi( counts.back().ascii() );
+
+            PiecewiseLinearCaseSplit region;
+            for ( unsigned j = 0; j < numBounds; ++j )
+                region.storeBoundTightening( stringToTightening( file->readLine() ) );
+
+            for ( unsigned j = 0; j < numEquations; ++j )
+            {
+                line = file->readLine();
+                List<String> tokens = line.tokenize( "," );
+                if ( tokens.size() < 2 || tokens.size() % 2 != 0 )
+                    throw MarabouError( MarabouError::INVALID_CHECKPOINT, line.ascii() );
+
+                auto it = tokens.begin();
+                int type = atoi( it->ascii() );
+                if ( type != Equation::EQ && type != Equation::GE && type != Equation::LE )
+                    throw MarabouError( MarabouError::INVALID_CHECKPOINT, line.ascii() );
+                Equation equation( (Equation::EquationType)type );
+                ++it;
+                equation.setScalar( atof( it->ascii() ) );
+                ++it;
+
+                while ( it != tokens.end() )
+                {
+                    unsigned variable = atoi( it->ascii() );
+                    ++it;
+                    double coefficient = atof( it->ascii() );
+                    ++it;
+                    equation.addAddend( coefficient, variable );
+                }
+
+                region.addEquation( equation );
+            }
+
+            regions.append( region );
+        }
+    }
+    catch ( const CommonError &e )
+    {
+        // The file ended prematurely
+        if ( e.getCode() == CommonError::READ_FAILED )
+            throw MarabouError( MarabouError::INVALID_CHECKPOINT, path.ascii() );
+        throw;
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,90 @@
+/*********************                                                        */
+/*! \file Checkpoint.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A checkpoint of a long-running search: the regions of the (preprocessed)
+ ** query that have not been proven UNSAT yet, each given as a case split,
+ ** together with the tightenings that were learned to hold globally.
+ ** Everything outside of the regions has been proven UNSAT, so a resumed
+ ** run only needs to solve the regions.
+ **
+ ** Variables are indices of the preprocessed query. Preprocessing is
+ ** deterministic, so a checkpoint can be resumed by a run on the same
+ ** network, property and options. To catch mistakes, a checkpoint stores
+ ** a fingerprint of the preprocessed query and of the relevant options,
+ ** and is rejected if the resuming run's fingerprint differs.
+ **
+ ** In SnC mode, the DnCManager keeps track of the unsolved subqueries in
+ ** a Checkpoint object that is updated by the workers.
+
+**/
+
+#ifndef __Checkpoint_h__
+#define __Checkpoint_h__
+
+#include "InputQuery.h"
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "Tightening.h"
+
+#include <mutex>
+
+class Checkpoint
+{
+public:
+    /*
+      Keep track of the subqueries that are still unsolved. Thread-safe.
+    */
+    void addSubQuery( const String &queryId, const PiecewiseLinearCaseSplit &split );
+    void removeSubQuery( const String &queryId );
+    void getUnsolvedRegions( List<PiecewiseLinearCaseSplit> &regions ) const;
+
+    /*
+      A fingerprint of the preprocessed query (its variables, equations
+      and constraints) and of the options that affect how it is divided.
+    */
+    static String computeFingerprint( const InputQuery &preprocessedQuery );
+
+    /*
+      Write a checkpoint file. The file is first written under a temporary
+      name and then renamed, so that a run that is killed while writing
+      leaves the previous checkpoint intact.
+    */
+    static void write( const String &path,
+                       const String &fingerprint,
+                       const List<PiecewiseLinearCaseSplit> &regions,
+                       const List<Tightening> &globalTightenings );
+
+    /*
+      Read a checkpoint file written by write(). Throws a MarabouError if
+      the file is invalid, or if it was written with another fingerprint.
+    */
+    static void read( const String &path,
+                      const String &fingerprint,
+                      List<PiecewiseLinearCaseSplit> &regions,
+                      List<Tightening> &globalTightenings );
+
+private:
+    mutable std::mutex _mutex;
+    Map<String, PiecewiseLinearCaseSplit> _unsolvedSubQueries;
+
+    static String tighteningToString( const Tightening &tightening );
+    static Tightening stringToTightening( const String &line );
+};
+
+#endif // __Checkpoint_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -26,6 +26,7 @@
 #include "PiecewiseLinearCaseSplit.h"
 #include "PolarityBasedDivider.h"
 #include "QueryDivider.h"
+#include "ThreadPlacement.h"
 #include "TimeUtils.h"
 #include "Vector.h"
 #include <atomic>
@@ -44,8 +45,14 @@ void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine
                            unsigned threadId, unsigned onlineDivides,
                            float timeoutFactor, SnCDivideStrategy divideStrategy,
                            bool restoreTreeStates, unsigned verbosity,
-                           unsigned seed, bool parallelDeepSoI )
+                           unsigned seed, bool parallelDeepSoI,
+                           SubtreeHandoff *subtreeHandoff, int cpu,
+                           Checkpoint *checkpoint )
 {
+    // Pin the thread before the engine processes the input query, so that
+    // the engine's memory is first touched on the NUMA node of the core
+    ThreadPlacement::pinCurrentThread( cpu );
+
     unsigned cpuId = 0;
     (void) threadId;
     (void) cpuId;
@@ -60,6 +67,10 @@ void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine
     DnCWorker worker( workload, engine, std::ref( numUnsolvedSubQueries ),
                       std::ref( shouldQuitSolving ), threadId, onlineDivides,
                       timeoutFactor, divideStrategy, verbosity, parallelDeepSoI );
+    if ( subtreeHandoff )
+        worker.setSubtreeHandoff( subtreeHandoff );
+    if ( checkpoint )
+        worker.setCheckpoint( checkpoint );
     while ( !shouldQuitSolving.load() )
     {
         worker.popOneSubQueryAndSolve( restoreTreeStates );
@@ -73,8 +84,15 @@ DnCManager::DnCManager( InputQuery *inputQuery )
     , _timeoutReached( false )
     , _numUnsolvedSubQueries( 0 )
     , _verbosity( Options::get()->getInt( Options::VERBOSITY ) )
-    , _runParallelDeepSoI( !Options::get()->getBool( Options::NO_PARALLEL_DEEPSOI ) )
+    , _runTreeParallel( Options::get()->getBool( Options::TREE_PARALLEL ) )
+    , _checkpointFile( Options::get()->getString( Options::CHECKPOINT_FILE ) )
+    , _resumeFile( Options::get()->getString( Options::RESUME_FILE ) )
 {
+    // Checkpoints consist of the unsolved subqueries, which only exist in
+    // SnC mode
+    _runParallelDeepSoI = !Options::get()->getBool( Options::NO_PARALLEL_DEEPSOI ) &&
+        !_runTreeParallel && _checkpointFile == "" && _resumeFile == "";
+
     SnCDivideStrategy sncSplittingStrategy = Options::get()->getSnCDivideStrategy();
     if ( sncSplittingStrategy == SnCDivideStrategy::Auto )
     {
@@ -142,6 +160,11 @@ void DnCManager::solve()
         return;
     }
 
+    // Computed before the base engine starts solving, and so changing its
+    // copy of the preprocessed query
+    if ( _checkpointFile != "" || _resumeFile != "" )
+        _checkpointFingerprint = _baseEngine->getCheckpointFingerprint();
+
 #ifdef ENABLE_OPENBLAS
     // Now each worker occupies one thread. So SBT performed during the search
     // will be single-threaded.
@@ -153,6 +176,14 @@ void DnCManager::solve()
     for ( unsigned i = 0; i < numWorkers; ++i )
         quitThreads.append( _engines[i]->getQuitRequested() );
 
+    // Let the engines share the facts they learn at decision level 0, so
+    // that they do not rediscover them in every subquery
+    _sharedTightenings = std::unique_ptr<SharedTighteningChannel>
+        ( new SharedTighteningChannel
+          ( GlobalConfiguration::DNC_SHARED_TIGHTENINGS_CAPACITY ) );
+    for ( unsigned i = 0; i < numWorkers; ++i )
+        _engines[i]->setSharedTighteningChannel( _sharedTightenings.get() );
+
     // Partition the input query into initial subqueries, and place these
     // queries in the queue
     _workload = new WorkerQueue( 0 );
@@ -160,10 +191,30 @@ void DnCManager::solve()
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::workload" );
 
     SubQueries subQueries;
-    if ( !_runParallelDeepSoI )
+    if ( _resumeFile != "" )
+    {
+        resumeFromCheckpoint( subQueries );
+        if ( subQueries.empty() )
+        {
+            // Everything was proven UNSAT before the checkpoint
+            if ( _checkpointFile != "" )
+                Checkpoint::write( _checkpointFile, _checkpointFingerprint,
+                                   List<PiecewiseLinearCaseSplit>(), List<Tightening>() );
+            _exitCode = DnCManager::UNSAT;
+            return;
+        }
+    }
+    else if ( !_runParallelDeepSoI )
         initialDivide( subQueries );
     else
     {
+        // All workers search the same query, so let them share their best
+        // phase patterns and pseudo-impact scores
+        _sharedSoIState = std::unique_ptr<SharedSoIState>
+            ( new SharedSoIState( numWorkers ) );
+        for ( unsigned i = 0; i < numWorkers; ++i )
+            _engines[i]->setSharedSoIState( _sharedSoIState.get(), i );
+
         for ( unsigned i = 0; i < numWorkers; ++i )
         {
             // Create empty case splits to get each worker started.
@@ -191,11 +242,34 @@ void DnCManager::solve()
         }
     }
 
+    if ( _checkpointFile != "" )
+    {
+        _checkpoint = std::unique_ptr<Checkpoint>( new Checkpoint );
+        for ( const auto &subQuery : subQueries )
+            _checkpoint->addSubQuery( subQuery->_queryId, *subQuery->_split );
+    }
+
+    if ( _runTreeParallel )
+    {
+        _subtreeHandoff = std::unique_ptr<SubtreeHandoff>
+            ( new SubtreeHandoff( workload, _numUnsolvedSubQueries ) );
+        _subtreeHandoff->setCheckpoint( _checkpoint.get() );
+        for ( unsigned i = 0; i < numWorkers; ++i )
+            _engines[i]->setSubtreeHandoff( _subtreeHandoff.get() );
+    }
+
     unsigned onlineDivides = Options::get()->getInt( Options::NUM_ONLINE_DIVIDES );
     float timeoutFactor = Options::get()->getFloat( Options::TIMEOUT_FACTOR );
     bool restoreTreeStates = Options::get()->getBool( Options::RESTORE_TREE_STATES );
     unsigned seed = Options::get()->getInt( Options::SEED );
 
+    ThreadPlacementPolicy placementPolicy = Options::get()->getThreadPlacementPolicy();
+    Vector<List<unsigned>> topology;
+    if ( placementPolicy != ThreadPlacementPolicy::None )
+        ThreadPlacement::getTopology( topology );
+    Vector<int> cpus;
+    ThreadPlacement::assignCPUs( topology, placementPolicy, numWorkers, cpus );
+
     auto baseInputQuery = std::unique_ptr<InputQuery>
         ( new InputQuery( *( _baseEngine->getInputQuery() ) ) );
 
@@ -217,10 +291,18 @@ void DnCManager::solve()
                                         timeoutFactor, _sncSplittingStrategy,
                                         restoreTreeStates, _verbosity,
                                         _runParallelDeepSoI ? seed + threadId : seed,
-                                        _runParallelDeepSoI
+                                        _runParallelDeepSoI,
+                                        _subtreeHandoff.get(),
+                                        cpus[threadId],
+                                        _checkpoint.get()
                                         ) );
     }
 
+    unsigned long long checkpointIntervalInMicroSeconds =
+        (unsigned long long)Options::get()->getInt( Options::CHECKPOINT_INTERVAL ) *
+        (unsigned long long)MICROSECONDS_IN_SECOND;
+    struct timespec lastCheckpointTime = TimeUtils::sampleMicro();
+
     // Wait until either all subQueries are solved or a satisfying assignment is
     // found by some worker
     while ( !shouldQuitSolving.load() )
@@ -229,8 +311,21 @@ void DnCManager::solve()
         if ( _timeoutReached )
             shouldQuitSolving = true;
         else
+        {
+            if ( _checkpoint )
+            {
+                struct timespec now = TimeUtils::sampleMicro();
+                if ( TimeUtils::timePassed( lastCheckpointTime, now ) >=
+                     checkpointIntervalInMicroSeconds )
+                {
+                    writeCheckpoint();
+                    lastCheckpointTime = now;
+                }
+            }
+
             std::this_thread::sleep_for( std::chrono::milliseconds
                                          ( numWorkers ) );
+        }
     }
 
 
@@ -242,6 +337,11 @@ void DnCManager::solve()
         thread.join();
 
     updateDnCExitCode();
+
+    // Subqueries that were being solved when we quit are still registered,
+    // so the final checkpoint covers everything that is left to solve
+    if ( _checkpoint && _exitCode != DnCManager::SAT )
+        writeCheckpoint();
     return;
 }
 
@@ -474,6 +574,81 @@ void DnCManager::initialDivide( SubQueries &subQueries )
                                     *split, initialTimeout, subQueries );
 }
 
+void DnCManager::resumeFromCheckpoint( SubQueries &subQueries )
+{
+    List<PiecewiseLinearCaseSplit> regions;
+    List<Tightening> globalTightenings;
+    Checkpoint::read( _resumeFile, _checkpointFingerprint, regions, globalTightenings );
+    DNC_MANAGER_LOG( Stringf( "Resuming %u regions from %s", regions.size(),
+                              _resumeFile.ascii() ).ascii() );
+
+    SharedTighteningChannel::Region wholeDomain =
+        std::make_shared<const List<Tightening>>();
+    for ( const auto &tightening : globalTightenings )
+        _sharedTightenings->publish( tightening, wholeDomain );
+
+    const List<unsigned> inputVariables( _baseEngine->getInputVariables() );
+    unsigned initialTimeout = Options::get()->getInt( Options::INITIAL_TIMEOUT );
+
+    unsigned queryIdSuffix = 1;
+    for ( const auto &region : regions )
+    {
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = Stringf( "r%u", queryIdSuffix++ );
+        subQuery->_split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit( region ) );
+        // The largest-interval divider only keeps the bounds of the input
+        // variables, so other regions must not be divided
+        if ( _sncSplittingStrategy == SnCDivideStrategy::Polarity ||
+             isInputRegion( region, inputVariables ) )
+            subQuery->_timeoutInSeconds = initialTimeout;
+        else
+            subQuery->_timeoutInSeconds = 0;
+        subQuery->_depth = 0;
+        subQueries.append( subQuery );
+    }
+}
+
+bool DnCManager::isInputRegion( const PiecewiseLinearCaseSplit &region,
+                                const List<unsigned> &inputVariables )
+{
+    if ( !region.getEquations().empty() )
+        return false;
+
+    Map<unsigned, unsigned> numBounds;
+    for ( const auto &variable : inputVariables )
+        numBounds[variable] = 0;
+
+    for ( const auto &tightening : region.getBoundTightenings() )
+    {
+        if ( !numBounds.exists( tightening._variable ) )
+            return false;
+        ++numBounds[tightening._variable];
+    }
+
+    for ( const auto &entry : numBounds )
+    {
+        if ( entry.second < 2 )
+            return false;
+    }
+    return true;
+}
+
+void DnCManager::writeCheckpoint()
+{
+    List<PiecewiseLinearCaseSplit> regions;
+    _checkpoint->getUnsolvedRegions( regions );
+
+    // Tightenings published under the whole domain hold everywhere
+    unsigned cursor = 0;
+    List<Tightening> globalTightenings;
+    _sharedTightenings->collect( cursor, List<Tightening>(), globalTightenings );
+
+    DNC_MANAGER_LOG( Stringf( "Writing checkpoint with %u regions to %s",
+                              regions.size(), _checkpointFile.ascii() ).ascii() );
+    Checkpoint::write( _checkpointFile, _checkpointFingerprint, regions, globalTightenings );
+}
+
 void DnCManager::updateTimeoutReached( timespec startTime, unsigned long long
                                        timeoutInMicroSeconds )
 {
@@ -17,8 +17,12 @@
 #define __DnCManager_h__
 
 #include "SnCDivideStrategy.h"
+#include "Checkpoint.h"
 #include "Engine.h"
 #include "InputQuery.h"
+#include "SharedSoIState.h"
+#include "SharedTighteningChannel.h"
+#include "SubtreeHandoff.h"
 #include "SubQuery.h"
 #include "Vector.h"
 
@@ -83,7 +87,9 @@ private:
                           unsigned threadId, unsigned onlineDivides,
                           float timeoutFactor, SnCDivideStrategy divideStrategy,
                           bool restoreTreeStates, unsigned verbosity,
-                          unsigned seed, bool parallelDeepSoI );
+                          unsigned seed, bool parallelDeepSoI,
+                          SubtreeHandoff *subtreeHandoff, int cpu,
+                          Checkpoint *checkpoint );
 
     /*
       Create the base engine from the network and property files,
@@ -97,6 +103,25 @@ private:
     */
     void initialDivide( SubQueries &subQueries );
 
+    /*
+      Create a subquery for each region of the checkpoint we resume from,
+      and share the global tightenings stored in it with the workers.
+    */
+    void resumeFromCheckpoint( SubQueries &subQueries );
+
+    /*
+      Returns true if the region only bounds the input variables, and
+      bounds each of them from both sides.
+    */
+    static bool isInputRegion( const PiecewiseLinearCaseSplit &region,
+                               const List<unsigned> &inputVariables );
+
+    /*
+      Write the unsolved subqueries and the global tightenings to the
+      checkpoint file.
+    */
+    void writeCheckpoint();
+
     /*
       Read the exitCode of the engine of each thread, and update the manager's
       exitCode.
@@ -164,6 +189,35 @@ private:
       The strategy for dividing a query
     */
     SnCDivideStrategy _sncSplittingStrategy;
+
+    /*
+      Channel through which the workers share the tightenings they learn at
+      decision level 0
+    */
+    std::unique_ptr<SharedTighteningChannel> _sharedTightenings;
+
+    /*
+      In parallel DeepSoI mode, the phase patterns and pseudo-impact
+      scores shared by the workers
+    */
+    std::unique_ptr<SharedSoIState> _sharedSoIState;
+
+    /*
+      Whether to let busy workers hand off unexplored subtrees to idle
+      workers, and the object through which they do so
+    */
+    bool _runTreeParallel;
+    std::unique_ptr<SubtreeHandoff> _subtreeHandoff;
+
+    /*
+      The file to write checkpoints to and the file to resume from (empty
+      if none), the fingerprint of the preprocessed query, and the set of
+      unsolved subqueries that is checkpointed
+    */
+    String _checkpointFile;
+    String _resumeFile;
+    String _checkpointFingerprint;
+    std::unique_ptr<Checkpoint> _checkpoint;
 };
 
 #endif // __DnCManager_h__
@@ -14,10 +14,12 @@
  ** [[ Add lengthier description here ]]
  **/
 
+#include "BinaryQueryFormat.h"
 #include "DnCManager.h"
 #include "DnCMarabou.h"
 #include "File.h"
 #include "MStringf.h"
+#include "OnnxParser.h"
 #include "Options.h"
 #include "PropertyParser.h"
 #include "MarabouError.h"
@@ -63,9 +65,15 @@ void DnCMarabou::run()
         }
         printf( "Network: %s\n", networkFilePath.ascii() );
 
-        AcasParser acasParser( networkFilePath );
-        acasParser.generateQuery( _inputQuery );
-        _inputQuery.constructNetworkLevelReasoner();
+        if ( OnnxParser::isOnnxFile( networkFilePath ) )
+        {
+            OnnxParser( networkFilePath ).generateQuery( _inputQuery );
+        }
+        else
+        {
+            AcasParser acasParser( networkFilePath );
+            acasParser.generateQuery( _inputQuery );
+        }
 
         /*
           Step 2: extract the property in question
@@ -84,7 +92,10 @@ void DnCMarabou::run()
     String queryDumpFilePath = Options::get()->getString( Options::QUERY_DUMP_FILE );
     if ( queryDumpFilePath.length() > 0 )
     {
-        _inputQuery.saveQuery( queryDumpFilePath );
+        if ( BinaryQueryFormat::hasBinaryExtension( queryDumpFilePath ) )
+            _inputQuery.saveBinaryQuery( queryDumpFilePath );
+        else
+            _inputQuery.saveQuery( queryDumpFilePath );
         printf( "\nInput query successfully dumped to file\n" );
         exit( 0 );
     }
@@ -46,6 +46,9 @@ DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
     , _timeoutFactor( timeoutFactor )
     , _verbosity( verbosity )
     , _parallelDeepSoI( parallelDeepSoI )
+    , _subtreeHandoff( NULL )
+    , _idle( false )
+    , _checkpoint( NULL )
 {
     setQueryDivider( divideStrategy );
 
@@ -71,6 +74,16 @@ void DnCWorker::setQueryDivider( SnCDivideStrategy divideStrategy )
     }
 }
 
+void DnCWorker::setSubtreeHandoff( SubtreeHandoff *subtreeHandoff )
+{
+    _subtreeHandoff = subtreeHandoff;
+}
+
+void DnCWorker::setCheckpoint( Checkpoint *checkpoint )
+{
+    _checkpoint = checkpoint;
+}
+
 void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
 {
     SubQuery *subQuery = NULL;
@@ -79,6 +92,12 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
     // in most cases)
     if ( _workload->pop( subQuery ) )
     {
+        if ( _idle )
+        {
+            _idle = false;
+            _subtreeHandoff->workerIsBusy();
+        }
+
         String queryId = subQuery->_queryId;
         unsigned depth = subQuery->_depth;
         auto split = std::move( subQuery->_split );
@@ -120,11 +139,46 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         if ( result == IEngine::UNSAT )
         {
             // If UNSAT, continue to solve
+            if ( _checkpoint )
+                _checkpoint->removeSubQuery( queryId );
             *_numUnsolvedSubQueries -= 1;
             if ( _numUnsolvedSubQueries->load() == 0 || _parallelDeepSoI )
                 *_shouldQuitSolving = true;
             delete subQuery;
         }
+        else if ( result == IEngine::TIMEOUT && _engine->getNumHandedOffSubtrees() > 0 )
+        {
+            // Part of the region now belongs to other workers, so dividing
+            // the whole region again would solve those parts twice. Instead,
+            // requeue the parts of our search tree that are still open.
+            List<PiecewiseLinearCaseSplit> regions;
+            _engine->getOpenRegions( regions );
+
+            unsigned i = 0;
+            for ( const auto &region : regions )
+            {
+                SubQuery *newSubQuery = new SubQuery;
+                newSubQuery->_queryId = Stringf( "%s-r%u", queryId.ascii(), ++i );
+                newSubQuery->_split = std::unique_ptr<PiecewiseLinearCaseSplit>
+                    ( new PiecewiseLinearCaseSplit( region ) );
+                // As for handed-off subtrees, the input divider would drop
+                // the case splits of the region
+                newSubQuery->_timeoutInSeconds = 0;
+                newSubQuery->_depth = depth + 1;
+
+                if ( _checkpoint )
+                    _checkpoint->addSubQuery( newSubQuery->_queryId,
+                                              *newSubQuery->_split );
+
+                *_numUnsolvedSubQueries += 1;
+                if ( !_workload->push( newSubQuery ) )
+                    throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
+            }
+            if ( _checkpoint )
+                _checkpoint->removeSubQuery( queryId );
+            *_numUnsolvedSubQueries -= 1;
+            delete subQuery;
+        }
         else if ( result == IEngine::TIMEOUT )
         {
             // If TIMEOUT, split the current input region and add the
@@ -157,6 +211,12 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                     newSubQuery->_smtState = std::move( newSmtStates[i++] );
                 }
 
+                // Register the child before it can be picked up, and before
+                // its parent is removed
+                if ( _checkpoint )
+                    _checkpoint->addSubQuery( newSubQuery->_queryId,
+                                              *newSubQuery->_split );
+
                 if ( !_workload->push( std::move( newSubQuery ) ) )
                 {
                     throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
@@ -164,6 +224,8 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
 
                 *_numUnsolvedSubQueries += 1;
             }
+            if ( _checkpoint )
+                _checkpoint->removeSubQuery( queryId );
             *_numUnsolvedSubQueries -= 1;
             delete subQuery;
         }
@@ -204,6 +266,11 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
     else
     {
         // If the queue is empty but the pop fails, wait and retry
+        if ( _subtreeHandoff && !_idle )
+        {
+            _idle = true;
+            _subtreeHandoff->workerIsIdle();
+        }
         std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
     }
 }
@@ -17,9 +17,11 @@
 #define __DnCWorker_h__
 
 #include "SnCDivideStrategy.h"
+#include "Checkpoint.h"
 #include "Engine.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "QueryDivider.h"
+#include "SubtreeHandoff.h"
 
 #include <atomic>
 
@@ -39,6 +41,19 @@ public:
     */
     void popOneSubQueryAndSolve( bool restoreTreeStates = false );
 
+    /*
+      Tree-parallel mode: report to the given object whenever this worker
+      runs out of work, so that busy workers can hand off subtrees to it.
+    */
+    void setSubtreeHandoff( SubtreeHandoff *subtreeHandoff );
+
+    /*
+      Keep the set of unsolved subqueries in the given checkpoint up to
+      date: solved subqueries are removed, and divided subqueries are
+      replaced by their children.
+    */
+    void setCheckpoint( Checkpoint *checkpoint );
+
 private:
     /*
       Initiate the query-divider object
@@ -83,6 +98,15 @@ private:
     float _timeoutFactor;
     unsigned _verbosity;
     bool _parallelDeepSoI;
+
+    /*
+      Tree-parallel mode: the object to which we report being idle, and
+      whether we are idle
+    */
+    SubtreeHandoff *_subtreeHandoff;
+    bool _idle;
+
+    Checkpoint *_checkpoint;
 };
 
 #endif // __DnCWorker_h__
@@ -67,6 +67,21 @@ Engine::Engine()
     , _milpSolverBoundTighteningType( Options::get()->getMILPSolverBoundTighteningType() )
     , _sncMode( false )
     , _queryId( "" )
+    , _sharedTightenings( NULL )
+    , _sharedTighteningsRegion( nullptr )
+    , _sharedTighteningsRegionIsBounds( true )
+    , _sharedTighteningsCursor( 0 )
+    , _sharedSoIState( NULL )
+    , _sharedSoIStateWorkerId( 0 )
+    , _sharedSoIStateVersion( 0 )
+    , _numProposalsSinceSoIExchange( 0 )
+    , _subtreeHandoff( NULL )
+    , _numHandedOffSubtrees( 0 )
+    , _checkpointFile( "" )
+    , _checkpointIntervalInMicroSeconds( 0 )
+    , _checkpointFingerprint( "" )
+    , _propertyInfeasible( false )
+    , _numberOfOriginalVariables( 0 )
 {
     _smtCore.setStatistics( &_statistics );
     _tableau->setStatistics( &_statistics );
@@ -86,6 +101,9 @@ Engine::Engine()
 
 Engine::~Engine()
 {
+    for ( const auto &scope : _incrementalScopes )
+        delete scope._state;
+
     if ( _work )
     {
         delete[] _work;
@@ -118,6 +136,20 @@ void Engine::applySnCSplit( PiecewiseLinearCaseSplit sncSplit, String queryId )
   _sncSplit = sncSplit;
   _queryId = queryId;
   applySplit( sncSplit );
+
+  // Everything imported so far was undone when the engine was restored for
+  // this subquery, and the new region may admit tightenings that the
+  // previous one did not. Re-scan the shared channel from the start.
+  // Regions are compared by their bounds alone, so a region that also
+  // carries equations (e.g., from a handed-off AbsoluteValue split) can
+  // neither soundly export its tightenings nor import other ones.
+  _sharedTighteningsRegion = std::make_shared<const List<Tightening>>
+      ( sncSplit.getBoundTightenings() );
+  _sharedTighteningsRegionIsBounds = sncSplit.getEquations().empty();
+  _sharedTighteningsCursor = 0;
+  _publishedSharedTightenings.clear();
+  _importedSharedTightenings.clear();
+  _numHandedOffSubtrees = 0;
 }
 
 void Engine::setRandomSeed( unsigned seed )
@@ -125,6 +157,149 @@ void Engine::setRandomSeed( unsigned seed )
     srand( seed );
 }
 
+void Engine::setSharedTighteningChannel( SharedTighteningChannel *channel )
+{
+    _sharedTightenings = channel;
+}
+
+void Engine::setSharedSoIState( SharedSoIState *state, unsigned workerId )
+{
+    _sharedSoIState = state;
+    _sharedSoIStateWorkerId = workerId;
+}
+
+void Engine::setSubtreeHandoff( SubtreeHandoff *subtreeHandoff )
+{
+    _subtreeHandoff = subtreeHandoff;
+}
+
+void Engine::handOffSubtreeIfNeeded()
+{
+    if ( !_subtreeHandoff || !_subtreeHandoff->idleWorkersNeedWork() )
+        return;
+
+    List<PiecewiseLinearCaseSplit> splitPath;
+    if ( !_smtCore.donateOpenSubtree( splitPath ) )
+        return;
+
+    String queryId = Stringf( "%s-t%u", _queryId.ascii(), ++_numHandedOffSubtrees );
+    ENGINE_LOG( Stringf( "Handing off subtree %s (%u splits)",
+                         queryId.ascii(), splitPath.size() ).ascii() );
+    _subtreeHandoff->handOff( _sncSplit, splitPath, queryId );
+}
+
+void Engine::setCheckpointFile( const String &path, unsigned intervalInSeconds )
+{
+    _checkpointFile = path;
+    _checkpointIntervalInMicroSeconds = (unsigned long long)intervalInSeconds * 1000000;
+    _lastCheckpointTime = TimeUtils::sampleMicro();
+}
+
+void Engine::writeCheckpointIfNeeded()
+{
+    if ( _checkpointFile == "" )
+        return;
+
+    struct timespec now = TimeUtils::sampleMicro();
+    if ( TimeUtils::timePassed( _lastCheckpointTime, now ) <
+         _checkpointIntervalInMicroSeconds )
+        return;
+
+    writeCheckpoint( _checkpointFile );
+    _lastCheckpointTime = now;
+}
+
+unsigned Engine::getNumHandedOffSubtrees() const
+{
+    return _numHandedOffSubtrees;
+}
+
+void Engine::getOpenRegions( List<PiecewiseLinearCaseSplit> &regions ) const
+{
+    List<List<PiecewiseLinearCaseSplit>> splitPaths;
+    _smtCore.getOpenSubtrees( splitPaths );
+
+    regions.clear();
+    for ( const auto &splitPath : splitPaths )
+    {
+        PiecewiseLinearCaseSplit region;
+        SubtreeHandoff::mergeSplits( _sncSplit, splitPath, region );
+        regions.append( region );
+    }
+}
+
+String Engine::getCheckpointFingerprint() const
+{
+    return _checkpointFingerprint;
+}
+
+void Engine::writeCheckpoint( const String &path ) const
+{
+    List<PiecewiseLinearCaseSplit> regions;
+    getOpenRegions( regions );
+
+    // Splits implied at the root hold everywhere, unless we are solving a
+    // subquery
+    List<Tightening> globalTightenings;
+    if ( !_sncMode )
+    {
+        for ( const auto &split : _smtCore.getImpliedValidSplitsAtRoot() )
+            globalTightenings.append( split.getBoundTightenings() );
+    }
+
+    ENGINE_LOG( Stringf( "Writing checkpoint with %u regions to %s",
+                         regions.size(), path.ascii() ).ascii() );
+    Checkpoint::write( path, getCheckpointFingerprint(), regions, globalTightenings );
+}
+
+void Engine::publishSharedTightenings( const PiecewiseLinearCaseSplit &validSplit )
+{
+    if ( !_sharedTightenings || !_sharedTighteningsRegionIsBounds ||
+         _smtCore.getStackDepth() != 0 )
+        return;
+
+    for ( const auto &tightening : validSplit.getBoundTightenings() )
+    {
+        // Skip what we already shared under this region, and what another
+        // worker has shared under a region that contains ours
+        if ( _importedSharedTightenings.implies( tightening ) ||
+             !_publishedSharedTightenings.update( tightening ) )
+            continue;
+
+        if ( _sharedTightenings->publish( tightening, _sharedTighteningsRegion ) )
+            _statistics.incUnsignedAttribute( Statistics::NUM_SHARED_TIGHTENINGS_PUBLISHED );
+        else if ( _sharedTightenings->reportSaturation() )
+            printf( "Engine: the shared tightening channel is full, level-0 "
+                    "tightenings are no longer shared between workers\n" );
+    }
+}
+
+void Engine::importSharedTightenings()
+{
+    if ( !_sharedTightenings || !_sharedTighteningsRegionIsBounds )
+        return;
+
+    List<Tightening> newTightenings;
+    _sharedTightenings->collect( _sharedTighteningsCursor,
+                                 _sharedTighteningsRegion ?
+                                 *_sharedTighteningsRegion : List<Tightening>(),
+                                 newTightenings );
+
+    unsigned numImported = 0;
+    for ( const auto &tightening : newTightenings )
+    {
+        if ( _importedSharedTightenings.update( tightening ) )
+            ++numImported;
+    }
+    _statistics.incUnsignedAttribute( Statistics::NUM_SHARED_TIGHTENINGS_IMPORTED,
+                                      numImported );
+
+    for ( const auto &bound : _importedSharedTightenings.getLowerBounds() )
+        _tableau->tightenLowerBound( bound.first, bound.second );
+    for ( const auto &bound : _importedSharedTightenings.getUpperBounds() )
+        _tableau->tightenUpperBound( bound.first, bound.second );
+}
+
 InputQuery Engine::prepareSnCInputQuery()
 {
     List<Tightening> bounds = _sncSplit.getBoundTightenings();
@@ -186,6 +361,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
         printf( "\n---\n" );
     }
 
+    importSharedTightenings();
     applyAllValidConstraintCaseSplits();
 
     bool splitJustPerformed = true;
@@ -209,6 +385,8 @@ bool Engine::solve( unsigned timeoutInSeconds )
 
             _exitCode = Engine::TIMEOUT;
             _statistics.timeout();
+            if ( _checkpointFile != "" )
+                writeCheckpoint( _checkpointFile );
             return false;
         }
 
@@ -222,9 +400,13 @@ bool Engine::solve( unsigned timeoutInSeconds )
             }
 
             _exitCode = Engine::QUIT_REQUESTED;
+            if ( _checkpointFile != "" )
+                writeCheckpoint( _checkpointFile );
             return false;
         }
 
+        writeCheckpointIfNeeded();
+
         try
         {
             DEBUG( _tableau->verifyInvariants() );
@@ -264,6 +446,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
             if ( _smtCore.needToSplit() )
             {
                 _smtCore.performSplit();
+                handOffSubtreeIfNeeded();
                 splitJustPerformed = true;
                 continue;
             }
@@ -1295,6 +1478,8 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
     ENGINE_LOG( "processInputQuery starting\n" );
     struct timespec start = TimeUtils::sampleMicro();
 
+    _numberOfOriginalVariables = inputQuery.getNumberOfVariables();
+
     try
     {
         informConstraintsOfInitialBounds( inputQuery );
@@ -1302,6 +1487,11 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
         if ( _verbosity > 0 )
             printInputBounds( inputQuery );
 
+        // Taken before the search changes the state of the constraints
+        if ( Options::get()->getString( Options::CHECKPOINT_FILE ) != "" ||
+             Options::get()->getString( Options::RESUME_FILE ) != "" )
+            _checkpointFingerprint = Checkpoint::computeFingerprint( *_preprocessedQuery );
+
         initializeNetworkLevelReasoning();
         if ( preprocess )
         {
@@ -1962,6 +2152,7 @@ bool Engine::applyValidConstraintCaseSplit( PiecewiseLinearConstraint *constrain
         PiecewiseLinearCaseSplit validSplit = constraint->getValidCaseSplit();
         _smtCore.recordImpliedValidSplit( validSplit );
         applySplit( validSplit );
+        publishSharedTightenings( validSplit );
         if ( _soiManager )
             _soiManager->removeCostComponentFromHeuristicCost( constraint );
         ++_numPlConstraintsDisabledByValidSplits;
@@ -2317,6 +2508,7 @@ void Engine::postContextPopHook()
 
     _boundManager.restoreLocalBounds();
     _tableau->postContextPopHook();
+    importSharedTightenings();
 
     struct timespec end = TimeUtils::sampleMicro();
     _statistics.incLongAttribute( Statistics::TIME_CONTEXT_POP_HOOK, TimeUtils::timePassed( start, end ) );
@@ -2888,8 +3080,11 @@ bool Engine::performDeepSoILocalSearch()
         }
 
         // No satisfying assignment found for the last accepted phase pattern,
-        // propose an update to it.
-        _soiManager->proposePhasePatternUpdate();
+        // propose an update to it. In parallel DeepSoI, we periodically
+        // propose instead a phase pattern found by another thread.
+        bool proposedSharedPhasePattern = exchangeSoIInformation();
+        if ( !proposedSharedPhasePattern )
+            _soiManager->proposePhasePatternUpdate();
         minimizeHeuristicCost( _soiManager->getCurrentSoIPhasePattern() );
         _soiManager->updateCurrentPhasePatternForSatisfiedPLConstraints();
         costOfProposedPhasePattern = computeHeuristicCost
@@ -2901,10 +3096,21 @@ bool Engine::performDeepSoILocalSearch()
         updatePseudoImpactWithSoICosts( costOfLastAcceptedPhasePattern,
                                         costOfProposedPhasePattern );
 
-        // Decide whether to accept the last proposal.
-        if ( _soiManager->decideToAcceptCurrentProposal
-             ( costOfLastAcceptedPhasePattern, costOfProposedPhasePattern ) )
+        // Decide whether to accept the last proposal. A shared phase pattern
+        // is only taken if it improves on ours under our own bounds.
+        bool acceptProposal = proposedSharedPhasePattern ?
+            FloatUtils::lt( costOfProposedPhasePattern, costOfLastAcceptedPhasePattern ) :
+            _soiManager->decideToAcceptCurrentProposal
+            ( costOfLastAcceptedPhasePattern, costOfProposedPhasePattern );
+        if ( acceptProposal )
         {
+            if ( proposedSharedPhasePattern )
+            {
+                ENGINE_LOG( Stringf( "Adopting a shared phase pattern with cost %f",
+                                     costOfProposedPhasePattern ).ascii() );
+                _statistics.incLongAttribute( Statistics::NUM_ADOPTED_SHARED_PHASE_PATTERNS );
+            }
+
             _soiManager->acceptCurrentPhasePattern();
             costOfLastAcceptedPhasePattern = costOfProposedPhasePattern;
             lastProposalAccepted = true;
@@ -3009,6 +3215,64 @@ void Engine::bumpUpPseudoImpactOfPLConstraintsNotInSoI()
     }
 }
 
+bool Engine::exchangeSoIInformation()
+{
+    if ( !_sharedSoIState ||
+         ++_numProposalsSinceSoIExchange < GlobalConfiguration::DEEP_SOI_SHARING_INTERVAL )
+        return false;
+    _numProposalsSinceSoIExchange = 0;
+
+    ASSERT( _soiManager );
+
+    if ( _plConstraintsByIndex.empty() )
+    {
+        for ( const auto &plConstraint : _plConstraints )
+        {
+            _plConstraintToIndex[plConstraint] = _plConstraintsByIndex.size();
+            _plConstraintsByIndex.append( plConstraint );
+        }
+    }
+
+    // Exchange the pseudo-impact scores, and blend the average over all
+    // threads into ours rather than overwriting what we learned locally
+    Vector<double> scores;
+    for ( const auto &plConstraint : _plConstraintsByIndex )
+        scores.append( _smtCore.getPLConstraintScore( plConstraint ) );
+    Vector<double> averageScores;
+    _sharedSoIState->exchangeScores( _sharedSoIStateWorkerId, scores, averageScores );
+    double weight = GlobalConfiguration::DEEP_SOI_SHARED_SCORE_WEIGHT;
+    for ( unsigned i = 0; i < _plConstraintsByIndex.size(); ++i )
+        _smtCore.setPLConstraintScore( _plConstraintsByIndex[i],
+                                       ( 1 - weight ) * scores[i] +
+                                       weight * averageScores[i] );
+
+    // Propose the phase pattern last published by another thread, if any.
+    // Its cost is evaluated by the caller, under our own bounds.
+    Map<unsigned, PhaseStatus> phasePattern;
+    bool foundPhasePattern =
+        _sharedSoIState->getPhasePattern( _sharedSoIStateWorkerId,
+                                          _sharedSoIStateVersion, phasePattern );
+
+    // Publish our own phase pattern
+    Map<unsigned, PhaseStatus> ownPhasePattern;
+    for ( const auto &pair : _soiManager->getLastAcceptedPhaseStatuses() )
+        ownPhasePattern[_plConstraintToIndex[pair.first]] = pair.second;
+    _sharedSoIStateVersion =
+        _sharedSoIState->publishPhasePattern( _sharedSoIStateWorkerId, ownPhasePattern );
+
+    if ( !foundPhasePattern )
+        return false;
+
+    Map<PiecewiseLinearConstraint *, PhaseStatus> sharedPhasePattern;
+    for ( const auto &pair : phasePattern )
+    {
+        if ( pair.first < _plConstraintsByIndex.size() )
+            sharedPhasePattern[_plConstraintsByIndex[pair.first]] = pair.second;
+    }
+
+    return _soiManager->proposePhasePattern( sharedPhasePattern );
+}
+
 void Engine::informLPSolverOfBounds()
 {
     if ( _lpSolverType == LPSolverType::GUROBI )
@@ -3106,4 +3370,246 @@ InputQuery Engine::buildQueryFromCurrentState() const {
         query.setUpperBound( i, _tableau->getUpperBound( i ) );
     }
     return query;
-}
\ No newline at end of file
+}
+
+void Engine::push()
+{
+    popInternalScopes();
+    pushScope( false );
+}
+
+void Engine::pop()
+{
+    popInternalScopes();
+    if ( _incrementalScopes.empty() )
+        throw MarabouError( MarabouError::NO_SCOPE_TO_POP );
+    popScope();
+}
+
+unsigned Engine::getNumberOfScopes() const
+{
+    unsigned numberOfScopes = 0;
+    for ( const auto &scope : _incrementalScopes )
+        if ( !scope._internal )
+            ++numberOfScopes;
+    return numberOfScopes;
+}
+
+void Engine::pushScope( bool internal )
+{
+    ENGINE_LOG( Stringf( "Pushing scope %u", _incrementalScopes.size() + 1 ).ascii() );
+
+    IncrementalScope scope;
+    scope._state = new EngineState;
+    scope._internal = internal;
+    scope._propertyInfeasible = _propertyInfeasible;
+    scope._numberOfDisjunctions = _propertyDisjunctions.size();
+    storeState( *scope._state, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE );
+
+    ASSERT( static_cast<unsigned>( _context.getLevel() ) == _incrementalScopes.size() );
+    preContextPushHook();
+    _context.push();
+    _incrementalScopes.append( scope );
+    _smtCore.setRootLevel( _context.getLevel() );
+}
+
+void Engine::popScope()
+{
+    ENGINE_LOG( Stringf( "Popping scope %u", _incrementalScopes.size() ).ascii() );
+
+    IncrementalScope scope = _incrementalScopes.back();
+    _incrementalScopes.popBack();
+
+    // Discard the case splits of the last search along with the scope
+    _smtCore.reset();
+    _context.popto( _incrementalScopes.size() );
+    postContextPopHook();
+    restoreState( *scope._state );
+    delete scope._state;
+
+    _smtCore.setRootLevel( _context.getLevel() );
+    _smtCore.initializeScoreTrackerIfNeeded( _plConstraints );
+    _propertyInfeasible = scope._propertyInfeasible;
+    while ( _propertyDisjunctions.size() > scope._numberOfDisjunctions )
+        _propertyDisjunctions.popBack();
+    clearViolatedPLConstraints();
+    resetExitCode();
+
+    // The tableau of the initial state may have changed
+    _initialStateStored = false;
+}
+
+void Engine::popInternalScopes()
+{
+    while ( !_incrementalScopes.empty() && _incrementalScopes.back()._internal )
+        popScope();
+}
+
+bool Engine::getPropertyVariable( unsigned variable, unsigned &tableauVariable, double &fixedValue ) const
+{
+    if ( variable >= _numberOfOriginalVariables )
+        throw MarabouError( MarabouError::VARIABLE_INDEX_OUT_OF_RANGE,
+                            Stringf( "Variable = %u, number of variables = %u (property)",
+                                     variable, _numberOfOriginalVariables ).ascii() );
+
+    if ( _preprocessingEnabled )
+    {
+        while ( _preprocessor.variableIsMerged( variable ) )
+            variable = _preprocessor.getMergedIndex( variable );
+
+        if ( _preprocessor.variableIsFixed( variable ) )
+        {
+            fixedValue = _preprocessor.getFixedValue( variable );
+            return false;
+        }
+
+        variable = _preprocessor.getNewIndex( variable );
+    }
+
+    tableauVariable = _tableau->getVariableAfterMerging( variable );
+    return true;
+}
+
+void Engine::addPropertyBound( const Tightening &tightening )
+{
+    popInternalScopes();
+    applyPropertyBound( tightening );
+}
+
+void Engine::addPropertyEquation( const Equation &equation )
+{
+    popInternalScopes();
+    applyPropertyEquation( equation );
+}
+
+void Engine::addPropertyDisjunction( const List<PiecewiseLinearCaseSplit> &disjuncts )
+{
+    popInternalScopes();
+
+    // Check the variables now, as the disjuncts are only applied during
+    // the search
+    unsigned variable;
+    double fixedValue;
+    for ( const auto &disjunct : disjuncts )
+    {
+        for ( const auto &tightening : disjunct.getBoundTightenings() )
+            getPropertyVariable( tightening._variable, variable, fixedValue );
+        for ( const auto &equation : disjunct.getEquations() )
+            for ( const auto &addend : equation._addends )
+                getPropertyVariable( addend._variable, variable, fixedValue );
+    }
+
+    if ( disjuncts.empty() )
+        _propertyInfeasible = true;
+    else
+        _propertyDisjunctions.append( disjuncts );
+}
+
+void Engine::applyPropertyBound( const Tightening &tightening )
+{
+    unsigned variable;
+    double fixedValue;
+    if ( !getPropertyVariable( tightening._variable, variable, fixedValue ) )
+    {
+        if ( ( tightening._type == Tightening::LB && FloatUtils::gt( tightening._value, fixedValue ) ) ||
+             ( tightening._type == Tightening::UB && FloatUtils::lt( tightening._value, fixedValue ) ) )
+            _propertyInfeasible = true;
+        return;
+    }
+
+    PiecewiseLinearCaseSplit split;
+    split.storeBoundTightening( Tightening( variable, tightening._value, tightening._type ) );
+    applySplit( split );
+    _initialStateStored = false;
+}
+
+void Engine::applyPropertyEquation( const Equation &equation )
+{
+    // Variables that preprocessing fixed become part of the scalar
+    Equation translated( equation._type );
+    double scalar = equation._scalar;
+    for ( const auto &addend : equation._addends )
+    {
+        unsigned variable;
+        double fixedValue;
+        if ( getPropertyVariable( addend._variable, variable, fixedValue ) )
+            translated.addAddend( addend._coefficient, variable );
+        else
+            scalar -= addend._coefficient * fixedValue;
+    }
+    translated.setScalar( scalar );
+
+    if ( translated._addends.empty() )
+    {
+        // The equation is now 0 <type> scalar
+        if ( ( translated._type == Equation::EQ && !FloatUtils::isZero( scalar ) ) ||
+             ( translated._type == Equation::GE && FloatUtils::isPositive( scalar ) ) ||
+             ( translated._type == Equation::LE && FloatUtils::isNegative( scalar ) ) )
+            _propertyInfeasible = true;
+        return;
+    }
+
+    PiecewiseLinearCaseSplit split;
+    split.addEquation( translated );
+    applySplit( split );
+    _initialStateStored = false;
+}
+
+bool Engine::solveIncrementally( unsigned timeoutInSeconds )
+{
+    popInternalScopes();
+
+    // The search runs in a scope of its own, so that the next change to
+    // the property can start from the state before it
+    pushScope( true );
+    clearViolatedPLConstraints();
+    resetSmtCore();
+    resetExitCode();
+
+    // The statistics add up over the searches, but the time limit is
+    // per search
+    _statistics.stampStartingTime();
+
+    return solveDisjunctions( _propertyDisjunctions.begin(), timeoutInSeconds );
+}
+
+bool Engine::solveDisjunctions( List<List<PiecewiseLinearCaseSplit>>::const_iterator disjunction,
+                                unsigned timeoutInSeconds )
+{
+    if ( _propertyInfeasible || !_tableau->allBoundsValid() )
+    {
+        _exitCode = Engine::UNSAT;
+        return false;
+    }
+
+    if ( disjunction == _propertyDisjunctions.end() )
+        return solve( timeoutInSeconds );
+
+    auto nextDisjunction = disjunction;
+    ++nextDisjunction;
+
+    // The time limit is shared by all disjuncts, so there is no point in
+    // trying more of them once the search stops for another reason than
+    // unsatisfiability
+    ExitCode exitCode = Engine::UNSAT;
+    for ( const auto &disjunct : *disjunction )
+    {
+        pushScope( true );
+        for ( const auto &tightening : disjunct.getBoundTightenings() )
+            applyPropertyBound( tightening );
+        for ( const auto &equation : disjunct.getEquations() )
+            applyPropertyEquation( equation );
+
+        if ( solveDisjunctions( nextDisjunction, timeoutInSeconds ) )
+            return true;
+
+        exitCode = _exitCode;
+        popScope();
+        if ( exitCode != Engine::UNSAT )
+            break;
+    }
+
+    _exitCode = exitCode;
+    return false;
+}
+
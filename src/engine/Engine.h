@@ -22,6 +22,7 @@
 #include "AutoTableau.h"
 #include "BlandsRule.h"
 #include "BoundManager.h"
+#include "Checkpoint.h"
 #include "DantzigsRule.h"
 #include "DegradationChecker.h"
 #include "DivideStrategy.h"
@@ -36,12 +37,16 @@
 #include "Options.h"
 #include "PrecisionRestorer.h"
 #include "Preprocessor.h"
+#include "SharedSoIState.h"
+#include "SharedTighteningChannel.h"
 #include "SignalHandler.h"
 #include "SmtCore.h"
 #include "SnCDivideStrategy.h"
+#include "SubtreeHandoff.h"
 #include "Statistics.h"
 #include "SumOfInfeasibilitiesManager.h"
 #include "SymbolicBoundTighteningType.h"
+#include "Tightening.h"
 
 #include <context/context.h>
 #include <atomic>
@@ -210,6 +215,9 @@ public:
      */
     void applySnCSplit( PiecewiseLinearCaseSplit sncSplit, String queryId );
 
+    unsigned getNumHandedOffSubtrees() const;
+    void getOpenRegions( List<PiecewiseLinearCaseSplit> &regions ) const;
+
     /*
        Apply bound tightenings stored in the bound manager.
      */
@@ -229,6 +237,64 @@ public:
 
     void setRandomSeed( unsigned seed );
 
+    /*
+      DnC mode: share level-0 tightenings with the other workers through
+      the given channel. The channel is owned by the caller.
+    */
+    void setSharedTighteningChannel( SharedTighteningChannel *channel );
+
+    /*
+      Parallel DeepSoI: periodically exchange the last accepted phase
+      pattern and the pseudo-impact scores with the other threads through
+      the given state, in which this engine is identified by workerId. The
+      state is owned by the caller.
+    */
+    void setSharedSoIState( SharedSoIState *state, unsigned workerId );
+
+    /*
+      DnC mode: hand off unexplored subtrees of the search tree to idle
+      workers through the given object, which is owned by the caller.
+    */
+    void setSubtreeHandoff( SubtreeHandoff *subtreeHandoff );
+
+    /*
+      Periodically write the unexplored part of the search tree to the
+      given checkpoint file. A checkpoint is also written when the engine
+      quits due to a timeout or an external request.
+    */
+    void setCheckpointFile( const String &path, unsigned intervalInSeconds );
+
+    /*
+      Write a checkpoint of the current search state to the given file.
+    */
+    void writeCheckpoint( const String &path ) const;
+
+    /*
+      The fingerprint of the preprocessed query that checkpoints are
+      tagged with.
+    */
+    String getCheckpointFingerprint() const;
+
+    /*
+      Incremental solving of many properties of one network. Once the
+      network has been processed, push() opens a scope, the property
+      methods constrain the variables of the original input query within
+      it, and pop() discards everything added since the matching push().
+      solveIncrementally() may be called any number of times, and keeps
+      the preprocessed query, the network level reasoner and the tableau
+      between calls. Properties may only narrow the bounds that the
+      network was processed with, as preprocessing relied on them.
+      A disjunction holds if the bounds and equations of one of its
+      disjuncts do; the disjuncts are searched one after the other.
+    */
+    void push();
+    void pop();
+    unsigned getNumberOfScopes() const;
+    void addPropertyBound( const Tightening &tightening );
+    void addPropertyEquation( const Equation &equation );
+    void addPropertyDisjunction( const List<PiecewiseLinearCaseSplit> &disjuncts );
+    bool solveIncrementally( unsigned timeoutInSeconds = 0 );
+
 private:
 
     enum BasisRestorationRequired {
@@ -460,11 +526,80 @@ private:
      */
     String _queryId;
 
+    /*
+      DnC mode: the channel through which level-0 tightenings are shared
+      with other workers, the region (the SnC split) under which this
+      engine's level-0 tightenings hold, whether that region is described
+      by bounds alone (sharing is off otherwise), our read position in the
+      channel, and the tightest bounds published and imported so far.
+      Imported bounds are re-applied after every context pop, since a pop
+      may undo those that were imported below level 0.
+    */
+    SharedTighteningChannel *_sharedTightenings;
+    SharedTighteningChannel::Region _sharedTighteningsRegion;
+    bool _sharedTighteningsRegionIsBounds;
+    unsigned _sharedTighteningsCursor;
+    SharedTighteningChannel::TightestBounds _publishedSharedTightenings;
+    SharedTighteningChannel::TightestBounds _importedSharedTightenings;
+
+    /*
+      Parallel DeepSoI: the state shared with the other threads, our id in
+      it, the version of the shared phase pattern we last saw, and the number
+      of phase pattern proposals since we last exchanged information.
+      Constraints are identified across threads by their index in
+      _plConstraints; the index is computed lazily on the first exchange.
+    */
+    SharedSoIState *_sharedSoIState;
+    unsigned _sharedSoIStateWorkerId;
+    unsigned _sharedSoIStateVersion;
+    unsigned _numProposalsSinceSoIExchange;
+    Vector<PiecewiseLinearConstraint *> _plConstraintsByIndex;
+    Map<PiecewiseLinearConstraint *, unsigned> _plConstraintToIndex;
+
+    /*
+      DnC mode: used to hand off subtrees to idle workers, and the number
+      of subtrees handed off while solving the current subquery (used to
+      name the new subqueries).
+    */
+    SubtreeHandoff *_subtreeHandoff;
+    unsigned _numHandedOffSubtrees;
+
+    /*
+      The file to which checkpoints are written (empty if none), the
+      interval between two checkpoints, the time of the last one, and the
+      fingerprint of the preprocessed query.
+    */
+    String _checkpointFile;
+    unsigned long long _checkpointIntervalInMicroSeconds;
+    struct timespec _lastCheckpointTime;
+    String _checkpointFingerprint;
+
     /*
       Frequency to print the statistics.
     */
     unsigned _statisticsPrintingFrequency;
 
+    /*
+      Incremental solving: the open scopes, each with the engine state and
+      the infeasibility flag from when it was pushed. Internal scopes are
+      opened by solveIncrementally, and are closed before the next change
+      to the property. The flag records that the property contradicts the
+      value of a variable that preprocessing fixed. Property variables
+      are indices into the original query, of the given size.
+    */
+    struct IncrementalScope
+    {
+        EngineState *_state;
+        bool _internal;
+        bool _propertyInfeasible;
+        unsigned _numberOfDisjunctions;
+    };
+
+    List<IncrementalScope> _incrementalScopes;
+    bool _propertyInfeasible;
+    List<List<PiecewiseLinearCaseSplit>> _propertyDisjunctions;
+    unsigned _numberOfOriginalVariables;
+
     LinearExpression _heuristicCost;
 
     /*
@@ -523,6 +658,47 @@ private:
 
     bool applyValidConstraintCaseSplit( PiecewiseLinearConstraint *constraint );
 
+    /*
+      DnC mode: publish the bound tightenings of a split that was found to
+      be valid at decision level 0, and import (and re-apply) tightenings
+      published by other workers whose region contains ours.
+    */
+    void publishSharedTightenings( const PiecewiseLinearCaseSplit &validSplit );
+    void importSharedTightenings();
+
+    /*
+      DnC mode: if some worker is idle, hand off the largest unexplored
+      subtree on the SmtCore stack to it.
+    */
+    void handOffSubtreeIfNeeded();
+
+    /*
+      Write a checkpoint if a checkpoint file is set and the interval has
+      passed since the last one.
+    */
+    void writeCheckpointIfNeeded();
+
+    /*
+      Incremental solving helpers: open or close a scope, close the
+      scopes left open by the last call to solveIncrementally, and find
+      the tableau variable of a variable of the original input query
+      (returns false if preprocessing fixed it to a value instead).
+    */
+    void pushScope( bool internal );
+    void popScope();
+    void popInternalScopes();
+    bool getPropertyVariable( unsigned variable, unsigned &tableauVariable, double &fixedValue ) const;
+    void applyPropertyBound( const Tightening &tightening );
+    void applyPropertyEquation( const Equation &equation );
+
+    /*
+      Search the disjunctions from the given one on, applying one
+      disjunct of each in an internal scope. The scopes of a satisfiable
+      combination stay open, so that the solution can be extracted.
+    */
+    bool solveDisjunctions( List<List<PiecewiseLinearCaseSplit>>::const_iterator disjunction,
+                            unsigned timeoutInSeconds );
+
     /*
       Update statitstics, print them if needed.
     */
@@ -712,6 +888,16 @@ private:
     */
     void bumpUpPseudoImpactOfPLConstraintsNotInSoI();
 
+    /*
+      Parallel DeepSoI: every DEEP_SOI_SHARING_INTERVAL calls, publish the
+      last accepted phase pattern and the pseudo-impact scores, and blend
+      the average scores over all threads into ours. If another thread has
+      published a phase pattern since the last exchange, propose it in the
+      SoI manager and return true; the caller accepts it only if its cost
+      is lower than that of our last accepted phase pattern.
+    */
+    bool exchangeSoIInformation();
+
     /*
       If we are using an external solver for LP solving, we need to inform
       the solver of the up-to-date variable bounds before invoking it.
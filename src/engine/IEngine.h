@@ -59,6 +59,15 @@ public:
     */
     virtual void applySnCSplit( PiecewiseLinearCaseSplit split, String queryId ) = 0;
 
+    /*
+      Tree-parallel mode: the number of subtrees handed off to other workers
+      since the last SnC split was applied, and the regions of the search
+      tree that were neither explored nor handed off, each merged with the
+      SnC split.
+    */
+    virtual unsigned getNumHandedOffSubtrees() const = 0;
+    virtual void getOpenRegions( List<PiecewiseLinearCaseSplit> &regions ) const = 0;
+
     /*
       Hooks invoked before/after context push/pop to store/restore/update context independent data.
     */
@@ -13,13 +13,20 @@
 
  **/
 
+#include "AbsoluteValueConstraint.h"
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
+#include "ConstSimpleData.h"
 #include "Debug.h"
+#include "File.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
 #include "MStringf.h"
 #include "MarabouError.h"
 #include "MaxConstraint.h"
+#include "ReluConstraint.h"
+#include "SigmoidConstraint.h"
+#include "SignConstraint.h"
 
 #define INPUT_QUERY_LOG( x, ... ) LOG( GlobalConfiguration::INPUT_QUERY_LOGGING, "Input Query: %s\n", x )
 
@@ -145,6 +152,11 @@ double InputQuery::getSolutionValue( unsigned variable ) const
     return _solution.get( variable );
 }
 
+const Map<unsigned, double> &InputQuery::getSolution() const
+{
+    return _solution;
+}
+
 void InputQuery::addPiecewiseLinearConstraint( PiecewiseLinearConstraint *constraint )
 {
     _plConstraints.append( constraint );
@@ -450,6 +462,237 @@ void InputQuery::saveQuery( const String &fileName )
     queryFile->close();
 }
 
+void InputQuery::saveBinaryQuery( const String &fileName )
+{
+    std::vector<char> buffer;
+    auto append = [&buffer]( const void *data, unsigned long long size )
+    {
+        const char *bytes = (const char *)data;
+        buffer.insert( buffer.end(), bytes, bytes + size );
+    };
+    auto align = [&buffer]()
+    {
+        buffer.resize( BinaryQueryFormat::alignedSize( buffer.size() ), 0 );
+    };
+
+    unsigned numAddends = 0;
+    for ( const auto &equation : _equations )
+        numAddends += equation._addends.size();
+
+    BinaryQueryFormat::Header header;
+    memcpy( header._magic, BinaryQueryFormat::MAGIC, sizeof( header._magic ) );
+    header._version = BinaryQueryFormat::VERSION;
+    header._byteOrderMark = BinaryQueryFormat::BYTE_ORDER_MARK;
+    header._numberOfVariables = _numberOfVariables;
+    header._numInputVariables = getNumInputVariables();
+    header._numOutputVariables = getNumOutputVariables();
+    header._numLowerBounds = _lowerBounds.size();
+    header._numUpperBounds = _upperBounds.size();
+    header._numEquations = _equations.size();
+    header._numAddends = numAddends;
+    header._numConstraints = _plConstraints.size() + _tsConstraints.size();
+    append( &header, sizeof( header ) );
+    align();
+
+    // Input and output variables
+    for ( unsigned i = 0; i < header._numInputVariables; ++i )
+    {
+        uint32_t variable = inputVariableByIndex( i );
+        append( &variable, sizeof( variable ) );
+    }
+    align();
+    for ( unsigned i = 0; i < header._numOutputVariables; ++i )
+    {
+        uint32_t variable = outputVariableByIndex( i );
+        append( &variable, sizeof( variable ) );
+    }
+    align();
+
+    // Bounds
+    for ( const Map<unsigned, double> *bounds : { &_lowerBounds, &_upperBounds } )
+    {
+        for ( const auto &bound : *bounds )
+        {
+            uint32_t variable = bound.first;
+            append( &variable, sizeof( variable ) );
+        }
+        align();
+        for ( const auto &bound : *bounds )
+            append( &bound.second, sizeof( double ) );
+        align();
+    }
+
+    // Equations, in compressed sparse row form
+    for ( const auto &equation : _equations )
+    {
+        uint32_t type = equation._type;
+        append( &type, sizeof( type ) );
+    }
+    align();
+    for ( const auto &equation : _equations )
+        append( &equation._scalar, sizeof( double ) );
+    align();
+    uint32_t offset = 0;
+    append( &offset, sizeof( offset ) );
+    for ( const auto &equation : _equations )
+    {
+        offset += equation._addends.size();
+        append( &offset, sizeof( offset ) );
+    }
+    align();
+    for ( const auto &equation : _equations )
+    {
+        for ( const auto &addend : equation._addends )
+        {
+            uint32_t variable = addend._variable;
+            append( &variable, sizeof( variable ) );
+        }
+    }
+    align();
+    for ( const auto &equation : _equations )
+    {
+        for ( const auto &addend : equation._addends )
+            append( &addend._coefficient, sizeof( double ) );
+    }
+    align();
+
+    // Non-linear constraints, as typed records
+    for ( const auto &constraint : _plConstraints )
+    {
+        BinaryQueryFormat::ConstraintRecord record;
+        memset( &record, 0, sizeof( record ) );
+        List<uint32_t> elements;
+        List<PiecewiseLinearCaseSplit> disjuncts;
+
+        switch ( constraint->getType() )
+        {
+        case RELU:
+        {
+            const ReluConstraint *relu = (const ReluConstraint *)constraint;
+            record._type = BinaryQueryFormat::RELU_CONSTRAINT;
+            record._b = relu->getB();
+            record._f = relu->getF();
+            if ( relu->auxVariableInUse() )
+            {
+                record._numAuxVariables = 1;
+                record._aux[0] = relu->getAux();
+            }
+            break;
+        }
+
+        case MAX:
+        {
+            const MaxConstraint *max = (const MaxConstraint *)constraint;
+            record._type = BinaryQueryFormat::MAX_CONSTRAINT;
+            record._f = max->getF();
+            for ( const auto &element : max->getElements() )
+                elements.append( element );
+            record._numElements = elements.size();
+            record._haveEliminatedPhases = max->haveFeasibleEliminatedPhases();
+            record._maxValueOfEliminatedPhases = max->getMaxValueOfEliminatedPhases();
+            break;
+        }
+
+        case ABSOLUTE_VALUE:
+        {
+            const AbsoluteValueConstraint *abs = (const AbsoluteValueConstraint *)constraint;
+            record._type = BinaryQueryFormat::ABSOLUTE_VALUE_CONSTRAINT;
+            record._b = abs->getB();
+            record._f = abs->getF();
+            if ( abs->auxVariablesInUse() )
+            {
+                record._numAuxVariables = 2;
+                record._aux[0] = abs->getPosAux();
+                record._aux[1] = abs->getNegAux();
+            }
+            break;
+        }
+
+        case SIGN:
+        {
+            const SignConstraint *sign = (const SignConstraint *)constraint;
+            record._type = BinaryQueryFormat::SIGN_CONSTRAINT;
+            record._b = sign->getB();
+            record._f = sign->getF();
+            break;
+        }
+
+        case DISJUNCTION:
+            record._type = BinaryQueryFormat::DISJUNCTION_CONSTRAINT;
+            disjuncts = constraint->getCaseSplits();
+            record._numElements = disjuncts.size();
+            break;
+
+        default:
+            throw MarabouError( MarabouError::UNSUPPORTED_PIECEWISE_LINEAR_CONSTRAINT,
+                                Stringf( "Unsupported piecewise-linear constraint type: %u\n",
+                                         constraint->getType() ).ascii() );
+        }
+
+        append( &record, sizeof( record ) );
+
+        for ( const auto &element : elements )
+            append( &element, sizeof( element ) );
+        align();
+
+        for ( const auto &disjunct : disjuncts )
+        {
+            BinaryQueryFormat::DisjunctRecord disjunctRecord;
+            disjunctRecord._numBounds = disjunct.getBoundTightenings().size();
+            disjunctRecord._numEquations = disjunct.getEquations().size();
+            append( &disjunctRecord, sizeof( disjunctRecord ) );
+
+            for ( const auto &bound : disjunct.getBoundTightenings() )
+            {
+                BinaryQueryFormat::BoundRecord boundRecord;
+                boundRecord._variable = bound._variable;
+                boundRecord._type = bound._type;
+                boundRecord._value = bound._value;
+                append( &boundRecord, sizeof( boundRecord ) );
+            }
+
+            for ( const auto &equation : disjunct.getEquations() )
+            {
+                BinaryQueryFormat::EquationRecord equationRecord;
+                equationRecord._type = equation._type;
+                equationRecord._numAddends = equation._addends.size();
+                equationRecord._scalar = equation._scalar;
+                append( &equationRecord, sizeof( equationRecord ) );
+
+                for ( const auto &addend : equation._addends )
+                {
+                    BinaryQueryFormat::AddendRecord addendRecord;
+                    addendRecord._variable = addend._variable;
+                    addendRecord._padding = 0;
+                    addendRecord._coefficient = addend._coefficient;
+                    append( &addendRecord, sizeof( addendRecord ) );
+                }
+            }
+        }
+    }
+
+    for ( const auto &constraint : _tsConstraints )
+    {
+        if ( constraint->getType() != SIGMOID )
+            throw MarabouError( MarabouError::UNSUPPORTED_TRANSCENDENTAL_CONSTRAINT,
+                                Stringf( "Unsupported transcendental constraint type: %u\n",
+                                         constraint->getType() ).ascii() );
+
+        const SigmoidConstraint *sigmoid = (const SigmoidConstraint *)constraint;
+        BinaryQueryFormat::ConstraintRecord record;
+        memset( &record, 0, sizeof( record ) );
+        record._type = BinaryQueryFormat::SIGMOID_CONSTRAINT;
+        record._b = sigmoid->getB();
+        record._f = sigmoid->getF();
+        append( &record, sizeof( record ) );
+    }
+
+    File queryFile( fileName );
+    queryFile.open( IFile::MODE_WRITE_TRUNCATE );
+    queryFile.write( ConstSimpleData( buffer.data(), buffer.size() ) );
+    queryFile.close();
+}
+
 void InputQuery::markInputVariable( unsigned variable, unsigned inputIndex )
 {
     _variableToInputIndex[variable] = inputIndex;
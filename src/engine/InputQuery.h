@@ -75,6 +75,7 @@ public:
     */
     void setSolutionValue( unsigned variable, double value );
     double getSolutionValue( unsigned variable ) const;
+    const Map<unsigned, double> &getSolution() const;
 
     /*
       Count the number of infinite bounds in the input query.
@@ -113,6 +114,13 @@ public:
     */
     void saveQuery( const String &fileName );
 
+    /*
+      Serializes the query to a file in the binary query format (see
+      BinaryQueryFormat.h), which QueryLoader loads much faster than the
+      text format.
+    */
+    void saveBinaryQuery( const String &fileName );
+
     /*
       Print input and output bounds
     */
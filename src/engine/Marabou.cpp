@@ -16,10 +16,13 @@
 
 #include "AcasParser.h"
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
+#include "Checkpoint.h"
 #include "GlobalConfiguration.h"
 #include "File.h"
 #include "MStringf.h"
 #include "Marabou.h"
+#include "OnnxParser.h"
 #include "Options.h"
 #include "PropertyParser.h"
 #include "MarabouError.h"
@@ -91,10 +94,16 @@ void Marabou::prepareInputQuery()
         }
         printf( "Network: %s\n", networkFilePath.ascii() );
 
-        // For now, assume the network is given in ACAS format
-        _acasParser = new AcasParser( networkFilePath );
-        _acasParser->generateQuery( _inputQuery );
-        _inputQuery.constructNetworkLevelReasoner();
+        if ( OnnxParser::isOnnxFile( networkFilePath ) )
+        {
+            OnnxParser( networkFilePath ).generateQuery( _inputQuery );
+        }
+        else
+        {
+            // Otherwise, assume the network is given in ACAS format
+            _acasParser = new AcasParser( networkFilePath );
+            _acasParser->generateQuery( _inputQuery );
+        }
 
         /*
           Step 2: extract the property in question
@@ -117,7 +126,10 @@ void Marabou::prepareInputQuery()
     String queryDumpFilePath = Options::get()->getString( Options::QUERY_DUMP_FILE );
     if ( queryDumpFilePath.length() > 0 )
     {
-        _inputQuery.saveQuery( queryDumpFilePath );
+        if ( BinaryQueryFormat::hasBinaryExtension( queryDumpFilePath ) )
+            _inputQuery.saveBinaryQuery( queryDumpFilePath );
+        else
+            _inputQuery.saveQuery( queryDumpFilePath );
         printf( "\nInput query successfully dumped to file\n" );
         exit( 0 );
     }
@@ -179,9 +191,19 @@ void Marabou::exportAssignment() const
 
 void Marabou::solveQuery()
 {
+    String checkpointFile = Options::get()->getString( Options::CHECKPOINT_FILE );
+    if ( checkpointFile != "" )
+        _engine.setCheckpointFile( checkpointFile,
+                                   Options::get()->getInt( Options::CHECKPOINT_INTERVAL ) );
+
     if ( _engine.processInputQuery( _inputQuery ) )
         _engine.solve( Options::get()->getInt( Options::TIMEOUT ) );
 
+    // Nothing is left to solve
+    if ( checkpointFile != "" && _engine.getExitCode() == Engine::UNSAT )
+        Checkpoint::write( checkpointFile, _engine.getCheckpointFingerprint(),
+                           List<PiecewiseLinearCaseSplit>(), List<Tightening>() );
+
     if ( _engine.getExitCode() == Engine::SAT )
         _engine.extractSolution( _inputQuery );
 }
@@ -51,6 +51,9 @@ public:
         REQUESTED_NONEXISTENT_CASE_SPLIT = 25,
         UNABLE_TO_INITIALIZATION_PHASE_PATTERN = 26,
         BOUNDS_NOT_UP_TO_DATE_IN_LP_SOLVER = 27,
+        INVALID_CHECKPOINT = 28,
+        CHECKPOINT_MISMATCH = 29,
+        NO_SCOPE_TO_POP = 30,
 
         // Error codes for Query Loader
         FILE_DOES_NOT_EXIST = 100,
@@ -58,6 +61,7 @@ public:
         UNSUPPORTED_PIECEWISE_LINEAR_CONSTRAINT = 102,
         UNSUPPORTED_TRANSCENDENTAL_CONSTRAINT = 103,
         UNSUPPORTED_NON_LINEAR_CONSTRAINT = 104,
+        INVALID_BINARY_QUERY = 105,
 
         FEATURE_NOT_YET_SUPPORTED = 900,
 
@@ -43,6 +43,14 @@ MaxConstraint::MaxConstraint( unsigned f, const Set<unsigned> &elements )
 {
 }
 
+MaxConstraint::MaxConstraint( unsigned f, const Set<unsigned> &elements,
+                              double maxValueOfEliminatedPhases )
+    : MaxConstraint( f, elements )
+{
+    _haveFeasibleEliminatedPhases = true;
+    _maxValueOfEliminatedPhases = maxValueOfEliminatedPhases;
+}
+
 MaxConstraint::MaxConstraint( const String &serializedMax )
 {
     String constraintType = serializedMax.substring( 0, 3 );
@@ -359,6 +367,16 @@ unsigned MaxConstraint::getF() const
     return _f;
 }
 
+bool MaxConstraint::haveFeasibleEliminatedPhases() const
+{
+    return _haveFeasibleEliminatedPhases;
+}
+
+double MaxConstraint::getMaxValueOfEliminatedPhases() const
+{
+    return _maxValueOfEliminatedPhases;
+}
+
 bool MaxConstraint::satisfied() const
 {
     DEBUG({
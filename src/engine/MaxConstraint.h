@@ -62,6 +62,13 @@ public:
       f = max( elements )
     */
     MaxConstraint( unsigned f, const Set<unsigned> &elements );
+
+    /*
+      A constraint some of whose elements have been eliminated, the
+      maximal value of which is given
+    */
+    MaxConstraint( unsigned f, const Set<unsigned> &elements,
+                   double maxValueOfEliminatedPhases );
     MaxConstraint( const String &serializedMax );
 
     /*
@@ -105,6 +112,13 @@ public:
     List<unsigned> getElements() const;
     unsigned getF() const;
 
+    /*
+      Whether some elements have been eliminated, and the maximal value
+      of the eliminated elements.
+    */
+    bool haveFeasibleEliminatedPhases() const;
+    double getMaxValueOfEliminatedPhases() const;
+
     /*
       Returns true iff the assignment satisfies the constraint
     */
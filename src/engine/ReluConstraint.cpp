@@ -41,6 +41,13 @@ ReluConstraint::ReluConstraint( unsigned b, unsigned f )
 {
 }
 
+ReluConstraint::ReluConstraint( unsigned b, unsigned f, unsigned aux )
+    : ReluConstraint( b, f )
+{
+    _aux = aux;
+    _auxVarInUse = true;
+}
+
 ReluConstraint::ReluConstraint( const String &serializedRelu )
     : _haveEliminatedVariables( false )
 {
@@ -45,6 +45,11 @@ public:
       f = relu( b )
     */
     ReluConstraint( unsigned b, unsigned f );
+
+    /*
+      A constraint that already uses the auxiliary variable aux = f - b
+    */
+    ReluConstraint( unsigned b, unsigned f, unsigned aux );
     ReluConstraint( const String &serializedRelu );
 
     /*
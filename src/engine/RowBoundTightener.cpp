@@ -63,6 +63,11 @@ void RowBoundTightener::setDimensions()
     _ciSign = new char[_n];
 }
 
+void RowBoundTightener::notifyDimensionChange( unsigned /* m */, unsigned /* n */ )
+{
+    setDimensions();
+}
+
 RowBoundTightener::~RowBoundTightener()
 {
     freeMemoryIfNeeded();
@@ -35,6 +35,11 @@ public:
     */
     void setDimensions();
 
+    /*
+      A row was added to the tableau: reallocate the work memory
+    */
+    void notifyDimensionChange( unsigned m, unsigned n );
+
     /*
        Method obtains lower bound of *var*.
      */
@@ -0,0 +1,80 @@
+/*********************                                                        */
+/*! \file SharedSoIState.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A single mutex guards the shared state. Threads only touch it every
+ ** few phase pattern proposals, so contention is low, and an atomic
+ ** version counter lets readers skip the lock when nothing has changed.
+
+**/
+
+#include "Debug.h"
+#include "SharedSoIState.h"
+
+SharedSoIState::SharedSoIState( unsigned numberOfWorkers )
+    : _version( 0 )
+    , _publisher( 0 )
+    , _scores( numberOfWorkers )
+{
+}
+
+unsigned SharedSoIState::publishPhasePattern( unsigned workerId,
+                                              const Map<unsigned, PhaseStatus> &pattern )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    _publisher = workerId;
+    _phasePattern = pattern;
+    return _version.fetch_add( 1, std::memory_order_release ) + 1;
+}
+
+bool SharedSoIState::getPhasePattern( unsigned workerId, unsigned &version,
+                                      Map<unsigned, PhaseStatus> &pattern ) const
+{
+    if ( _version.load( std::memory_order_acquire ) == version )
+        return false;
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    version = _version.load( std::memory_order_relaxed );
+    if ( _publisher == workerId )
+        return false;
+
+    pattern = _phasePattern;
+    return true;
+}
+
+void SharedSoIState::exchangeScores( unsigned workerId, const Vector<double> &scores,
+                                     Vector<double> &averageScores )
+{
+    ASSERT( workerId < _scores.size() );
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    _scores[workerId] = scores;
+
+    averageScores.assign( scores.size(), 0 );
+    Vector<unsigned> numberOfReports( scores.size(), 0 );
+    for ( const auto &workerScores : _scores )
+    {
+        for ( unsigned i = 0; i < workerScores.size() && i < scores.size(); ++i )
+        {
+            averageScores[i] += workerScores[i];
+            ++numberOfReports[i];
+        }
+    }
+
+    // Every entry has at least the report of workerId itself
+    for ( unsigned i = 0; i < scores.size(); ++i )
+        averageScores[i] /= numberOfReports[i];
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,85 @@
+/*********************                                                        */
+/*! \file SharedSoIState.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** State shared by the threads of a parallel DeepSoI run: the phase pattern
+ ** most recently published by any thread, and the pseudo-impact score of
+ ** each piecewise-linear constraint as seen by each thread. SoI costs are
+ ** not shared: threads search different nodes under different bounds, so
+ ** their costs are not comparable, and a thread evaluates a shared phase
+ ** pattern itself before adopting it. All threads
+ ** solve the same query, so constraints are identified by their index in the
+ ** engine's list of piecewise-linear constraints.
+
+**/
+
+#ifndef __SharedSoIState_h__
+#define __SharedSoIState_h__
+
+#include "Map.h"
+#include "PiecewiseLinearConstraint.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <mutex>
+
+class SharedSoIState
+{
+public:
+    SharedSoIState( unsigned numberOfWorkers );
+
+    /*
+      Publish the phase pattern of the given worker, replacing the shared
+      one. Returns the new version of the shared phase pattern.
+    */
+    unsigned publishPhasePattern( unsigned workerId, const Map<unsigned, PhaseStatus> &pattern );
+
+    /*
+      If the shared phase pattern has changed since the given version and
+      was published by a worker other than workerId, store it in pattern,
+      update version and return true. Otherwise return false; the lock is
+      not taken if nothing has changed.
+    */
+    bool getPhasePattern( unsigned workerId, unsigned &version,
+                          Map<unsigned, PhaseStatus> &pattern ) const;
+
+    /*
+      Record the pseudo-impact scores of the given worker, and store in
+      averageScores the mean score of each constraint over all workers that
+      have reported so far.
+    */
+    void exchangeScores( unsigned workerId, const Vector<double> &scores,
+                         Vector<double> &averageScores );
+
+private:
+    mutable std::mutex _mutex;
+
+    /*
+      Incremented whenever the phase pattern is replaced, so that readers
+      can cheaply check for news.
+    */
+    std::atomic_uint _version;
+    unsigned _publisher;
+    Map<unsigned, PhaseStatus> _phasePattern;
+
+    /*
+      The latest scores reported by each worker. An empty entry means that
+      the worker has not reported yet.
+    */
+    Vector<Vector<double>> _scores;
+};
+
+#endif // __SharedSoIState_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,194 @@
+/*********************                                                        */
+/*! \file SharedTighteningChannel.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Publishers reserve a slot with a single atomic increment and then
+ ** mark it ready; readers scan from their own cursor up to the first slot
+ ** that is not ready yet. Entries are never removed, so the channel needs
+ ** no locks.
+
+**/
+
+#include "Debug.h"
+#include "MarabouError.h"
+#include "SharedTighteningChannel.h"
+
+SharedTighteningChannel::SharedTighteningChannel( unsigned capacity )
+    : _capacity( capacity )
+    , _entries( NULL )
+    , _numReserved( 0 )
+    , _saturationReported( false )
+{
+    _entries = new Entry[_capacity];
+    if ( !_entries )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED,
+                            "SharedTighteningChannel::entries" );
+}
+
+SharedTighteningChannel::~SharedTighteningChannel()
+{
+    if ( _entries )
+    {
+        delete[] _entries;
+        _entries = NULL;
+    }
+}
+
+bool SharedTighteningChannel::publish( const Tightening &tightening,
+                                       const Region &region )
+{
+    // Cheap early exit, so that a full channel does not keep growing the
+    // reservation counter
+    if ( _numReserved.load( std::memory_order_relaxed ) >= _capacity )
+        return false;
+
+    unsigned index = _numReserved.fetch_add( 1 );
+    if ( index >= _capacity )
+        return false;
+
+    Entry &entry = _entries[index];
+    entry._variable = tightening._variable;
+    entry._value = tightening._value;
+    entry._type = tightening._type;
+    entry._region = region;
+
+    // Make the entry visible to the readers
+    entry._ready.store( true, std::memory_order_release );
+    return true;
+}
+
+void SharedTighteningChannel::collect( unsigned &cursor,
+                                       const List<Tightening> &ownRegion,
+                                       List<Tightening> &result ) const
+{
+    unsigned end = _numReserved.load( std::memory_order_acquire );
+    if ( end > _capacity )
+        end = _capacity;
+
+    // Consecutive entries are usually published under the same region, so
+    // remember the most recent containment check
+    const List<Tightening> *lastRegion = NULL;
+    bool lastRegionContainsOwn = false;
+
+    while ( cursor < end )
+    {
+        const Entry &entry = _entries[cursor];
+
+        // A publisher has reserved this slot but not yet filled it. Stop
+        // here and pick it up on the next call.
+        if ( !entry._ready.load( std::memory_order_acquire ) )
+            return;
+
+        ++cursor;
+
+        const List<Tightening> *region = entry._region.get();
+        if ( region != lastRegion )
+        {
+            lastRegion = region;
+            lastRegionContainsOwn =
+                ( region == NULL ) || regionContains( *region, ownRegion );
+        }
+
+        if ( lastRegionContainsOwn )
+            result.append( Tightening( entry._variable, entry._value, entry._type ) );
+    }
+}
+
+unsigned SharedTighteningChannel::getNumPublished() const
+{
+    unsigned reserved = _numReserved.load( std::memory_order_acquire );
+    return reserved > _capacity ? _capacity : reserved;
+}
+
+bool SharedTighteningChannel::reportSaturation()
+{
+    if ( _numReserved.load( std::memory_order_relaxed ) < _capacity )
+        return false;
+
+    return !_saturationReported.exchange( true );
+}
+
+bool SharedTighteningChannel::regionContains( const List<Tightening> &outer,
+                                              const List<Tightening> &inner )
+{
+    for ( const auto &outerBound : outer )
+    {
+        bool implied = false;
+        for ( const auto &innerBound : inner )
+        {
+            if ( innerBound._variable != outerBound._variable ||
+                 innerBound._type != outerBound._type )
+                continue;
+
+            if ( ( outerBound._type == Tightening::LB &&
+                   innerBound._value >= outerBound._value ) ||
+                 ( outerBound._type == Tightening::UB &&
+                   innerBound._value <= outerBound._value ) )
+            {
+                implied = true;
+                break;
+            }
+        }
+
+        if ( !implied )
+            return false;
+    }
+
+    return true;
+}
+
+bool SharedTighteningChannel::TightestBounds::update( const Tightening &tightening )
+{
+    if ( implies( tightening ) )
+        return false;
+
+    if ( tightening._type == Tightening::LB )
+        _lowerBounds[tightening._variable] = tightening._value;
+    else
+        _upperBounds[tightening._variable] = tightening._value;
+    return true;
+}
+
+bool SharedTighteningChannel::TightestBounds::implies( const Tightening &tightening ) const
+{
+    if ( tightening._type == Tightening::LB )
+        return _lowerBounds.exists( tightening._variable ) &&
+            _lowerBounds[tightening._variable] >= tightening._value;
+    else
+        return _upperBounds.exists( tightening._variable ) &&
+            _upperBounds[tightening._variable] <= tightening._value;
+}
+
+void SharedTighteningChannel::TightestBounds::clear()
+{
+    _lowerBounds.clear();
+    _upperBounds.clear();
+}
+
+bool SharedTighteningChannel::TightestBounds::empty() const
+{
+    return _lowerBounds.empty() && _upperBounds.empty();
+}
+
+const Map<unsigned, double> &SharedTighteningChannel::TightestBounds::getLowerBounds() const
+{
+    return _lowerBounds;
+}
+
+const Map<unsigned, double> &SharedTighteningChannel::TightestBounds::getUpperBounds() const
+{
+    return _upperBounds;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
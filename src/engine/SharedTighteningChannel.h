@@ -0,0 +1,145 @@
+/*********************                                                        */
+/*! \file SharedTighteningChannel.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A lock-free, append-only broadcast channel through which DnC workers
+ ** share bound tightenings (e.g., fixed ReLU phases) learned at decision
+ ** level 0. Every tightening is published together with the region (the
+ ** SnC split) under which it was derived, and a worker only imports a
+ ** tightening if its own region is contained in that region. Regions are
+ ** compared by their bounds only, so workers whose region also carries
+ ** split equations neither publish nor import.
+
+**/
+
+#ifndef __SharedTighteningChannel_h__
+#define __SharedTighteningChannel_h__
+
+#include "List.h"
+#include "Map.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "Tightening.h"
+
+#include <atomic>
+#include <memory>
+
+class SharedTighteningChannel
+{
+public:
+    /*
+      The region under which a tightening holds, given as a conjunction of
+      bound tightenings. An empty region stands for the whole input domain.
+    */
+    typedef std::shared_ptr<const List<Tightening>> Region;
+
+    /*
+      The tightest lower and upper bound seen for each variable. Used by
+      workers to skip tightenings that add nothing to what they already
+      published or imported.
+    */
+    class TightestBounds
+    {
+    public:
+        /*
+          Record a tightening. Returns true iff it is strictly tighter
+          than the bound recorded for its variable so far.
+        */
+        bool update( const Tightening &tightening );
+
+        /*
+          Returns true iff the tightening is implied by a recorded bound.
+        */
+        bool implies( const Tightening &tightening ) const;
+
+        void clear();
+        bool empty() const;
+
+        const Map<unsigned, double> &getLowerBounds() const;
+        const Map<unsigned, double> &getUpperBounds() const;
+
+    private:
+        Map<unsigned, double> _lowerBounds;
+        Map<unsigned, double> _upperBounds;
+    };
+
+    SharedTighteningChannel( unsigned capacity );
+    ~SharedTighteningChannel();
+
+    /*
+      Publish a tightening that is valid within the given region. Returns
+      false if the channel is full and the tightening was dropped.
+      Safe to call concurrently from multiple threads.
+    */
+    bool publish( const Tightening &tightening, const Region &region );
+
+    /*
+      Collect, into result, all tightenings published from position cursor
+      onwards whose region contains ownRegion. The cursor is advanced past
+      every entry that was examined. Each reader owns its cursor.
+    */
+    void collect( unsigned &cursor, const List<Tightening> &ownRegion,
+                  List<Tightening> &result ) const;
+
+    /*
+      The number of tightenings published so far.
+    */
+    unsigned getNumPublished() const;
+
+    /*
+      Returns true to the first caller after the channel has filled up,
+      and false otherwise, so that saturation is reported only once.
+    */
+    bool reportSaturation();
+
+    /*
+      Returns true iff every point satisfying inner also satisfies outer,
+      judging by the bound tightenings alone: each tightening in outer must
+      be implied by a tightening on the same variable in inner.
+    */
+    static bool regionContains( const List<Tightening> &outer,
+                                const List<Tightening> &inner );
+
+private:
+    struct Entry
+    {
+        Entry()
+            : _variable( 0 )
+            , _value( 0 )
+            , _type( Tightening::LB )
+            , _ready( false )
+        {
+        }
+
+        unsigned _variable;
+        double _value;
+        Tightening::BoundType _type;
+        Region _region;
+        std::atomic_bool _ready;
+    };
+
+    unsigned _capacity;
+    Entry *_entries;
+
+    /*
+      The number of slots that have been reserved by publishers. A slot is
+      only visible to readers once its _ready flag has been set.
+    */
+    std::atomic_uint _numReserved;
+
+    std::atomic_bool _saturationReported;
+};
+
+#endif // __SharedTighteningChannel_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
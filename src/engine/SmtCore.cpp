@@ -30,6 +30,7 @@ SmtCore::SmtCore( IEngine *engine )
     : _statistics( NULL )
     , _engine( engine )
     , _context( _engine->getContext() )
+    , _rootLevel( 0 )
     , _needToSplit( false )
     , _constraintForSplitting( NULL )
     , _stateId( 0 )
@@ -68,6 +69,12 @@ void SmtCore::reset()
     _numRejectedPhasePatternProposal = 0;
 }
 
+void SmtCore::setRootLevel( unsigned level )
+{
+    ASSERT( _stack.empty() );
+    _rootLevel = level;
+}
+
 void SmtCore::reportViolatedConstraint( PiecewiseLinearConstraint *constraint )
 {
     if ( !_constraintToViolationCount.exists( constraint ) )
@@ -207,7 +214,7 @@ void SmtCore::performSplit()
 
 unsigned SmtCore::getStackDepth() const
 {
-    ASSERT( _stack.size() == static_cast<unsigned>( _context.getLevel() ) );
+    ASSERT( _stack.size() + _rootLevel == static_cast<unsigned>( _context.getLevel() ) );
     return _stack.size();
 }
 
@@ -364,6 +371,52 @@ void SmtCore::allSplitsSoFar( List<PiecewiseLinearCaseSplit> &result ) const
     }
 }
 
+bool SmtCore::donateOpenSubtree( List<PiecewiseLinearCaseSplit> &splitPath )
+{
+    splitPath.clear();
+
+    // Implied valid splits are not part of the path: the receiver will
+    // derive them again from the active splits
+    for ( const auto &stackEntry : _stack )
+    {
+        if ( !stackEntry->_alternativeSplits.empty() )
+        {
+            auto split = stackEntry->_alternativeSplits.begin();
+            splitPath.append( *split );
+            stackEntry->_alternativeSplits.erase( split );
+
+            if ( _statistics )
+                _statistics->incUnsignedAttribute( Statistics::NUM_DONATED_SUBTREES );
+            return true;
+        }
+
+        splitPath.append( stackEntry->_activeSplit );
+    }
+
+    splitPath.clear();
+    return false;
+}
+
+void SmtCore::getOpenSubtrees( List<List<PiecewiseLinearCaseSplit>> &splitPaths ) const
+{
+    splitPaths.clear();
+
+    List<PiecewiseLinearCaseSplit> prefix;
+    for ( const auto &stackEntry : _stack )
+    {
+        for ( const auto &alternative : stackEntry->_alternativeSplits )
+        {
+            List<PiecewiseLinearCaseSplit> splitPath = prefix;
+            splitPath.append( alternative );
+            splitPaths.append( splitPath );
+        }
+
+        prefix.append( stackEntry->_activeSplit );
+    }
+
+    splitPaths.append( prefix );
+}
+
 void SmtCore::setStatistics( Statistics *statistics )
 {
     _statistics = statistics;
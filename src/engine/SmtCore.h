@@ -52,6 +52,12 @@ public:
     */
     void reset();
 
+    /*
+      The context level at which the search starts, i.e. the number of
+      incremental scopes that the engine has pushed below the stack.
+    */
+    void setRootLevel( unsigned level );
+
     /*
       Initialize the score tracker with the given list of pl constraints.
     */
@@ -73,6 +79,22 @@ public:
         _scoreTracker->updateScore( constraint, score );
     }
 
+    /*
+      Get/set the score of the constraint in the costTracker.
+    */
+    inline double getPLConstraintScore( PiecewiseLinearConstraint *constraint ) const
+    {
+        ASSERT( _scoreTracker != nullptr );
+        return _scoreTracker->getScore( constraint );
+    }
+
+    inline void setPLConstraintScore( PiecewiseLinearConstraint *constraint,
+                                      double score )
+    {
+        ASSERT( _scoreTracker != nullptr );
+        _scoreTracker->setScore( constraint, score );
+    }
+
     /*
       Get the constraint in the score tracker with the highest score
     */
@@ -142,6 +164,31 @@ public:
     */
     void allSplitsSoFar( List<PiecewiseLinearCaseSplit> &result ) const;
 
+    /*
+      Tree-parallel search: remove the first alternative split of the
+      shallowest stack entry that has one, so that another worker can
+      explore that subtree instead. Store in splitPath the active splits of
+      the entries above it, followed by the removed split. Returns false if
+      there is no alternative left on the stack.
+    */
+    bool donateOpenSubtree( List<PiecewiseLinearCaseSplit> &splitPath );
+
+    /*
+      Checkpointing: store in splitPaths the part of the search tree that
+      has not been explored yet, i.e., the current path and every
+      alternative split on the stack. Each is given as the active splits
+      leading to it, followed by the split itself.
+    */
+    void getOpenSubtrees( List<List<PiecewiseLinearCaseSplit>> &splitPaths ) const;
+
+    /*
+      The valid splits implied at decision level 0.
+    */
+    inline const List<PiecewiseLinearCaseSplit> &getImpliedValidSplitsAtRoot() const
+    {
+        return _impliedValidSplitsAtRoot;
+    }
+
     /*
       Have the SMT core start reporting statistics.
     */
@@ -206,6 +253,12 @@ private:
       Context for synchronizing the search.
      */
     Context &_context;
+
+    /*
+      The context level of an empty stack.
+    */
+    unsigned _rootLevel;
+
     /*
       Do we need to perform a split and on which constraint.
     */
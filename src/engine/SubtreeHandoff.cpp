@@ -0,0 +1,98 @@
+/*********************                                                        */
+/*! \file SubtreeHandoff.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Idle workers are counted with an atomic counter that busy engines poll
+ ** after every case split; a handed-off subtree is pushed to the shared
+ ** work queue like any other subquery.
+
+**/
+
+#include "Debug.h"
+#include "MarabouError.h"
+#include "SubtreeHandoff.h"
+
+SubtreeHandoff::SubtreeHandoff( WorkerQueue *workload,
+                                std::atomic_int &numUnsolvedSubQueries )
+    : _workload( workload )
+    , _numUnsolvedSubQueries( &numUnsolvedSubQueries )
+    , _numIdleWorkers( 0 )
+    , _checkpoint( NULL )
+{
+}
+
+void SubtreeHandoff::setCheckpoint( Checkpoint *checkpoint )
+{
+    _checkpoint = checkpoint;
+}
+
+void SubtreeHandoff::workerIsIdle()
+{
+    ++_numIdleWorkers;
+}
+
+void SubtreeHandoff::workerIsBusy()
+{
+    ASSERT( _numIdleWorkers.load() > 0 );
+    --_numIdleWorkers;
+}
+
+bool SubtreeHandoff::idleWorkersNeedWork() const
+{
+    // The emptiness check is only a heuristic (the queue may change right
+    // after it), but it keeps busy workers from flooding the queue: at most
+    // one handed-off subquery is pending at any time.
+    return _numIdleWorkers.load( std::memory_order_relaxed ) > 0 &&
+        _workload->empty();
+}
+
+void SubtreeHandoff::handOff( const PiecewiseLinearCaseSplit &region,
+                              const List<PiecewiseLinearCaseSplit> &splitPath,
+                              const String &queryId )
+{
+    auto split = std::unique_ptr<PiecewiseLinearCaseSplit>
+        ( new PiecewiseLinearCaseSplit );
+    mergeSplits( region, splitPath, *split );
+
+    SubQuery *subQuery = new SubQuery;
+    subQuery->_queryId = queryId;
+    subQuery->_split = std::move( split );
+    subQuery->_timeoutInSeconds = 0;
+    subQuery->_depth = 0;
+
+    if ( _checkpoint )
+        _checkpoint->addSubQuery( queryId, *subQuery->_split );
+
+    // Count the subquery before it becomes visible, so that the number of
+    // unsolved subqueries cannot drop to zero while it is pending
+    *_numUnsolvedSubQueries += 1;
+    if ( !_workload->push( subQuery ) )
+        throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
+}
+
+void SubtreeHandoff::mergeSplits( const PiecewiseLinearCaseSplit &region,
+                                  const List<PiecewiseLinearCaseSplit> &splitPath,
+                                  PiecewiseLinearCaseSplit &result )
+{
+    result = region;
+    for ( const auto &split : splitPath )
+    {
+        for ( const auto &tightening : split.getBoundTightenings() )
+            result.storeBoundTightening( tightening );
+        for ( const auto &equation : split.getEquations() )
+            result.addEquation( equation );
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
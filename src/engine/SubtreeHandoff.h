@@ -0,0 +1,84 @@
+/*********************                                                        */
+/*! \file SubtreeHandoff.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Tree-parallel search in SnC mode: DnC workers report when they run out
+ ** of work, and a busy engine then hands off an unexplored subtree of its
+ ** search tree (an alternative split on its SmtCore stack, together with
+ ** the splits leading to it) as a new subquery. The receiving worker
+ ** replays the split path on its own copy of the query.
+
+**/
+
+#ifndef __SubtreeHandoff_h__
+#define __SubtreeHandoff_h__
+
+#include "Checkpoint.h"
+#include "List.h"
+#include "MString.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "SubQuery.h"
+
+#include <atomic>
+
+class SubtreeHandoff
+{
+public:
+    SubtreeHandoff( WorkerQueue *workload, std::atomic_int &numUnsolvedSubQueries );
+
+    /*
+      Register the handed-off subqueries in the given checkpoint.
+    */
+    void setCheckpoint( Checkpoint *checkpoint );
+
+    /*
+      Called by the DnC workers when they fail to / succeed in obtaining a
+      subquery from the queue.
+    */
+    void workerIsIdle();
+    void workerIsBusy();
+
+    /*
+      Returns true if some worker is idle and there is no pending subquery
+      that it could pick up. Cheap enough to be called after every split.
+    */
+    bool idleWorkersNeedWork() const;
+
+    /*
+      Create a subquery from the given split path (the region of the donor,
+      followed by the case splits leading to the subtree) and push it to the
+      queue. Donated subqueries have no timeout: the input divider of SnC
+      only preserves bounds of input variables, and would drop the path.
+    */
+    void handOff( const PiecewiseLinearCaseSplit &region,
+                  const List<PiecewiseLinearCaseSplit> &splitPath,
+                  const String &queryId );
+
+    /*
+      Merge the given region and case splits into a single split.
+    */
+    static void mergeSplits( const PiecewiseLinearCaseSplit &region,
+                             const List<PiecewiseLinearCaseSplit> &splitPath,
+                             PiecewiseLinearCaseSplit &result );
+
+private:
+    WorkerQueue *_workload;
+    std::atomic_int *_numUnsolvedSubQueries;
+    std::atomic_uint _numIdleWorkers;
+    Checkpoint *_checkpoint;
+};
+
+#endif // __SubtreeHandoff_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -190,6 +190,29 @@ void SumOfInfeasibilitiesManager::proposePhasePatternUpdate()
     }
 }
 
+bool SumOfInfeasibilitiesManager::proposePhasePattern
+( const Map<PiecewiseLinearConstraint *, PhaseStatus> &phasePattern )
+{
+    _currentPhasePattern = _lastAcceptedPhasePattern;
+    _constraintsUpdatedInLastProposal.clear();
+
+    for ( const auto &pair : phasePattern )
+    {
+        if ( _currentPhasePattern.exists( pair.first ) &&
+             _currentPhasePattern[pair.first] != pair.second )
+        {
+            _currentPhasePattern[pair.first] = pair.second;
+            _constraintsUpdatedInLastProposal.append( pair.first );
+        }
+    }
+
+    if ( _statistics && !_constraintsUpdatedInLastProposal.empty() )
+        _statistics->incLongAttribute
+            ( Statistics::NUM_PROPOSED_PHASE_PATTERN_UPDATE );
+
+    return !_constraintsUpdatedInLastProposal.empty();
+}
+
 void SumOfInfeasibilitiesManager::proposePhasePatternUpdateRandomly()
 {
     SOI_LOG( "Proposing phase pattern update randomly..." );
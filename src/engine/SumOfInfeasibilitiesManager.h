@@ -49,6 +49,15 @@ public:
     */
     LinearExpression getLastAcceptedSoIPhasePattern() const;
 
+    /*
+      Returns the most recently accepted phase pattern, as a mapping from
+      PLConstraints to phase statuses
+    */
+    inline const Map<PiecewiseLinearConstraint *, PhaseStatus> &getLastAcceptedPhaseStatuses() const
+    {
+        return _lastAcceptedPhasePattern;
+    }
+
     /*
       Return the list of constraints updated in the last proposal.
       This list is updated during proposePhasePatternUpdate().
@@ -74,6 +83,16 @@ public:
     */
     void proposePhasePatternUpdate();
 
+    /*
+      Propose a phase pattern obtained from elsewhere (e.g., another thread
+      in parallel DeepSoI): starting from the last accepted phase pattern,
+      take the phase of each constraint from the given pattern. Constraints
+      that do not participate in the SoI are ignored. Returns false if this
+      does not change the last accepted phase pattern.
+    */
+    bool proposePhasePattern( const Map<PiecewiseLinearConstraint *, PhaseStatus>
+                              &phasePattern );
+
     /*
       The acceptance heuristic is standard: if the newCost is less than
       the current cost, we always accept. Otherwise, the probability
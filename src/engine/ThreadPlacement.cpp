@@ -0,0 +1,176 @@
+/*********************                                                        */
+/*! \file ThreadPlacement.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The core assignment works on an explicit topology, so that it does
+ ** not depend on the machine it runs on; only getTopology() reads sysfs.
+
+**/
+
+#include "CommonError.h"
+#include "Debug.h"
+#include "File.h"
+#include "MStringf.h"
+#include "ThreadPlacement.h"
+
+#include <cstdlib>
+
+#if defined( __linux__ )
+#include <sched.h>
+#endif
+
+void ThreadPlacement::assignCPUs( const Vector<List<unsigned>> &nodes,
+                                  ThreadPlacementPolicy policy,
+                                  unsigned numThreads, Vector<int> &cpus )
+{
+    cpus.assign( numThreads, NO_CPU );
+
+    // The order in which cores are handed out
+    List<unsigned> order;
+    if ( policy == ThreadPlacementPolicy::Compact )
+    {
+        for ( const auto &node : nodes )
+            order.append( node );
+    }
+    else if ( policy == ThreadPlacementPolicy::Scatter )
+    {
+        // Take the first core of every node, then the second core of every
+        // node, and so on
+        Vector<List<unsigned>::const_iterator> next;
+        for ( const auto &node : nodes )
+            next.append( node.begin() );
+
+        bool added = true;
+        while ( added )
+        {
+            added = false;
+            for ( unsigned i = 0; i < nodes.size(); ++i )
+            {
+                if ( next[i] != nodes[i].end() )
+                {
+                    order.append( *next[i] );
+                    ++next[i];
+                    added = true;
+                }
+            }
+        }
+    }
+
+    if ( order.empty() )
+        return;
+
+    auto it = order.begin();
+    for ( unsigned i = 0; i < numThreads; ++i )
+    {
+        cpus[i] = *it;
+        ++it;
+        if ( it == order.end() )
+            it = order.begin();
+    }
+}
+
+bool ThreadPlacement::pinCurrentThread( int cpu )
+{
+    if ( cpu == NO_CPU )
+        return false;
+
+#if defined( __linux__ )
+    cpu_set_t cpuSet;
+    CPU_ZERO( &cpuSet );
+    CPU_SET( cpu, &cpuSet );
+    return sched_setaffinity( 0, sizeof( cpuSet ), &cpuSet ) == 0;
+#else
+    return false;
+#endif
+}
+
+void ThreadPlacement::parseCPUList( const String &cpuList, List<unsigned> &cpus )
+{
+    cpus.clear();
+    for ( const auto &range : cpuList.trim().tokenize( "," ) )
+    {
+        List<String> bounds = range.tokenize( "-" );
+        if ( bounds.empty() )
+            continue;
+
+        unsigned first = (unsigned)atoi( bounds.front().ascii() );
+        unsigned last = (unsigned)atoi( bounds.back().ascii() );
+        for ( unsigned cpu = first; cpu <= last; ++cpu )
+            cpus.append( cpu );
+    }
+}
+
+void ThreadPlacement::getTopology( Vector<List<unsigned>> &nodes )
+{
+    nodes.clear();
+
+#if defined( __linux__ )
+    cpu_set_t allowed;
+    CPU_ZERO( &allowed );
+    if ( sched_getaffinity( 0, sizeof( allowed ), &allowed ) != 0 )
+        return;
+
+    List<unsigned> onlineNodes;
+    try
+    {
+        File onlineFile( "/sys/devices/system/node/online" );
+        onlineFile.open( File::MODE_READ );
+        parseCPUList( onlineFile.readLine(), onlineNodes );
+    }
+    catch ( const CommonError & )
+    {
+        // No NUMA information
+    }
+
+    for ( const auto &node : onlineNodes )
+    {
+        List<unsigned> nodeCPUs;
+        try
+        {
+            File cpuListFile( Stringf( "/sys/devices/system/node/node%u/cpulist", node ) );
+            cpuListFile.open( File::MODE_READ );
+            parseCPUList( cpuListFile.readLine(), nodeCPUs );
+        }
+        catch ( const CommonError & )
+        {
+            continue;
+        }
+
+        List<unsigned> allowedCPUs;
+        for ( const auto &cpu : nodeCPUs )
+        {
+            if ( cpu < CPU_SETSIZE && CPU_ISSET( cpu, &allowed ) )
+                allowedCPUs.append( cpu );
+        }
+
+        if ( !allowedCPUs.empty() )
+            nodes.append( allowedCPUs );
+    }
+
+    if ( nodes.empty() )
+    {
+        // Treat all the cores we may run on as a single node
+        List<unsigned> allowedCPUs;
+        for ( unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu )
+        {
+            if ( CPU_ISSET( cpu, &allowed ) )
+                allowedCPUs.append( cpu );
+        }
+        if ( !allowedCPUs.empty() )
+            nodes.append( allowedCPUs );
+    }
+#endif
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,69 @@
+/*********************                                                        */
+/*! \file ThreadPlacement.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Placement of the DnC worker threads on cores. The NUMA topology is read
+ ** from sysfs; on systems without it, all cores are treated as one node.
+ ** A worker pins itself before it processes its input query, so that the
+ ** memory of its engine is first touched, and hence allocated, on the node
+ ** it runs on.
+
+**/
+
+#ifndef __ThreadPlacement_h__
+#define __ThreadPlacement_h__
+
+#include "List.h"
+#include "MString.h"
+#include "ThreadPlacementPolicy.h"
+#include "Vector.h"
+
+class ThreadPlacement
+{
+public:
+    enum {
+        NO_CPU = -1,
+    };
+
+    /*
+      Compute the core for each of numThreads threads according to the
+      policy, on the given topology: nodes[i] lists the cores of NUMA node
+      i. Threads that should not be pinned get NO_CPU. If there are more
+      threads than cores, cores are reused.
+    */
+    static void assignCPUs( const Vector<List<unsigned>> &nodes,
+                            ThreadPlacementPolicy policy, unsigned numThreads,
+                            Vector<int> &cpus );
+
+    /*
+      Pin the calling thread to the given core. Returns false if this is
+      not supported or fails; the thread then keeps floating.
+    */
+    static bool pinCurrentThread( int cpu );
+
+    /*
+      Parse a cpulist in the sysfs format (e.g., "0-3,8,10-11").
+    */
+    static void parseCPUList( const String &cpuList, List<unsigned> &cpus );
+
+    /*
+      The topology of this machine: the cores of each NUMA node that this
+      process is allowed to run on. Nodes without such cores are skipped.
+    */
+    static void getTopology( Vector<List<unsigned>> &nodes );
+};
+
+#endif // __ThreadPlacement_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,37 @@
+/*********************                                                        */
+/*! \file ThreadPlacementPolicy.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The policies for pinning DnC worker threads to cores.
+
+**/
+
+#ifndef __ThreadPlacementPolicy_h__
+#define __ThreadPlacementPolicy_h__
+
+enum class ThreadPlacementPolicy
+{
+    // Let the OS schedule the worker threads
+    None = 0,
+
+    // Pin the workers to consecutive cores, filling one NUMA node first
+    Compact,
+
+    // Pin the workers to cores on alternating NUMA nodes
+    Scatter,
+};
+
+#endif // __ThreadPlacementPolicy_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
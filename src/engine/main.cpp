@@ -76,7 +76,23 @@ int main( int argc, char **argv )
             return 0;
         };
 
+        // Subtrees are handed off as SnC subqueries, so tree parallelism
+        // needs SnC mode, and takes the place of parallel DeepSoI
+        if ( options->getBool( Options::TREE_PARALLEL ) )
+        {
+            if ( !options->getBool( Options::DNC_MODE ) )
+            {
+                printf( "Error: --tree-parallel requires --snc\n" );
+                return 1;
+            }
+
+            if ( !options->getBool( Options::NO_PARALLEL_DEEPSOI ) )
+                printf( "Warning: --tree-parallel turns off parallel DeepSoI\n" );
+        }
+
+        // Checkpoints are resumed by solving their regions as subqueries
         if ( options->getBool( Options::DNC_MODE ) ||
+             options->getString( Options::RESUME_FILE ) != "" ||
              ( !options->getBool( Options::NO_PARALLEL_DEEPSOI ) &&
                !options->getBool( Options::SOLVE_WITH_MILP ) &&
                options->getInt( Options::NUM_WORKERS ) > 1 ) )
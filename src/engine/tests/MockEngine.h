@@ -33,6 +33,7 @@ public:
         wasDiscarded = false;
 
         lastStoredState = NULL;
+        numHandedOffSubtrees = 0;
     }
 
     ~MockEngine()
@@ -201,6 +202,18 @@ public:
     {
     }
 
+    unsigned numHandedOffSubtrees;
+    unsigned getNumHandedOffSubtrees() const
+    {
+        return numHandedOffSubtrees;
+    }
+
+    List<PiecewiseLinearCaseSplit> openRegions;
+    void getOpenRegions( List<PiecewiseLinearCaseSplit> &regions ) const
+    {
+        regions = openRegions;
+    }
+
     void applyAllBoundTightenings() {};
 
     bool applyAllValidConstraintCaseSplits() { return false; };
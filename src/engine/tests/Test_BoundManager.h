@@ -86,6 +86,39 @@ public:
                                          FloatUtils::infinity() ) );
     }
 
+    /*
+     * Growing the local bound arrays keeps the bounds of existing variables
+     */
+    void test_register_variable_keeps_bounds()
+    {
+        BoundManager boundManager( *context );
+
+        unsigned numberOfVariables = 3u;
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( numberOfVariables ) );
+        for ( unsigned i = 0; i < numberOfVariables; ++i )
+        {
+            boundManager.setLowerBound( i, -1.0 - i );
+            boundManager.setUpperBound( i, 1.0 + i );
+        }
+
+        for ( unsigned i = 0; i < 10; ++i )
+            TS_ASSERT_THROWS_NOTHING( boundManager.registerNewVariable() );
+        TS_ASSERT_EQUALS( boundManager.getNumberOfVariables(), 13u );
+
+        for ( unsigned i = 0; i < numberOfVariables; ++i )
+        {
+            TS_ASSERT_EQUALS( boundManager.getLowerBound( i ), -1.0 - i );
+            TS_ASSERT_EQUALS( boundManager.getUpperBound( i ), 1.0 + i );
+            TS_ASSERT_EQUALS( boundManager.getLowerBounds()[i], -1.0 - i );
+            TS_ASSERT_EQUALS( boundManager.getUpperBounds()[i], 1.0 + i );
+        }
+        for ( unsigned i = numberOfVariables; i < 13; ++i )
+        {
+            TS_ASSERT_EQUALS( boundManager.getLowerBounds()[i], FloatUtils::negativeInfinity() );
+            TS_ASSERT_EQUALS( boundManager.getUpperBounds()[i], FloatUtils::infinity() );
+        }
+    }
+
     /*
      * BoundManager throws infeasible query exception when some variable bounds
      * become invalid
@@ -0,0 +1,90 @@
+/*********************                                                        */
+/*! \file Test_Checkpoint.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Tests for the bookkeeping of unsolved subqueries and for checkpoint
+ ** fingerprints. Reading and writing checkpoint files is covered by the
+ ** checkpoint system test.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "Checkpoint.h"
+#include "InputQuery.h"
+#include "ReluConstraint.h"
+
+class CheckpointTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void test_unsolved_sub_queries()
+    {
+        Checkpoint checkpoint;
+
+        PiecewiseLinearCaseSplit split1;
+        split1.storeBoundTightening( Tightening( 0, 0, Tightening::LB ) );
+        PiecewiseLinearCaseSplit split2;
+        split2.storeBoundTightening( Tightening( 0, 0, Tightening::UB ) );
+
+        checkpoint.addSubQuery( "1", split1 );
+        checkpoint.addSubQuery( "2", split2 );
+        checkpoint.removeSubQuery( "1" );
+        checkpoint.removeSubQuery( "3" );
+
+        List<PiecewiseLinearCaseSplit> regions;
+        checkpoint.getUnsolvedRegions( regions );
+        TS_ASSERT_EQUALS( regions, List<PiecewiseLinearCaseSplit>( { split2 } ) );
+    }
+
+    void populateQuery( InputQuery &inputQuery, double coefficient )
+    {
+        inputQuery.setNumberOfVariables( 3 );
+
+        Equation equation;
+        equation.addAddend( coefficient, 0 );
+        equation.addAddend( -1, 1 );
+        equation.setScalar( 0 );
+        inputQuery.addEquation( equation );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 1, 2 ) );
+    }
+
+    void test_fingerprint()
+    {
+        InputQuery query1;
+        populateQuery( query1, 2 );
+        InputQuery query2;
+        populateQuery( query2, 2 );
+        InputQuery query3;
+        populateQuery( query3, 2.5 );
+
+        String fingerprint = Checkpoint::computeFingerprint( query1 );
+        TS_ASSERT_EQUALS( fingerprint.length(), 16U );
+        TS_ASSERT_EQUALS( fingerprint, Checkpoint::computeFingerprint( query2 ) );
+        TS_ASSERT_DIFFERS( fingerprint, Checkpoint::computeFingerprint( query3 ) );
+
+        query2.addPiecewiseLinearConstraint( new ReluConstraint( 0, 2 ) );
+        TS_ASSERT_DIFFERS( fingerprint, Checkpoint::computeFingerprint( query2 ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -258,6 +258,53 @@ public:
         TS_ASSERT( numUnsolvedSubQueries.load() == 1 );
         TS_ASSERT( shouldQuitSolving.load() );
     }
+
+    void test_timeout_after_handing_off_subtrees()
+    {
+        //  Pop a subQuery from the workload, and set the mock engine to
+        //  report timeout after handing off part of its search tree.
+        //  In this case, only the open regions of the engine are requeued,
+        //  without a timeout, instead of dividing the whole subQuery.
+        TS_ASSERT( clearSubQueries() == 0 );
+
+        createPlaceHolderSubQuery();
+        _engine->setTimeToSolve( 10 );
+        _engine->setExitCode( IEngine::TIMEOUT );
+        _engine->numHandedOffSubtrees = 1;
+
+        PiecewiseLinearCaseSplit region1;
+        region1.storeBoundTightening( Tightening( 1, 0, Tightening::UB ) );
+        PiecewiseLinearCaseSplit region2;
+        region2.storeBoundTightening( Tightening( 1, 0, Tightening::LB ) );
+        region2.storeBoundTightening( Tightening( 2, 4, Tightening::UB ) );
+        _engine->openRegions.append( region1 );
+        _engine->openRegions.append( region2 );
+
+        std::atomic_int numUnsolvedSubQueries( 1 );
+        std::atomic_bool shouldQuitSolving( false );
+        DnCWorker dncWorker( _workload, _engine, numUnsolvedSubQueries,
+                             shouldQuitSolving, 0, 2, 1,
+                             SnCDivideStrategy::LargestInterval, 0, false );
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 2 );
+        TS_ASSERT( !shouldQuitSolving.load() );
+
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( _workload->pop( subQuery ) );
+        TS_ASSERT_EQUALS( *subQuery->_split, region1 );
+        TS_ASSERT_EQUALS( subQuery->_timeoutInSeconds, 0U );
+        delete subQuery;
+
+        TS_ASSERT( _workload->pop( subQuery ) );
+        TS_ASSERT_EQUALS( *subQuery->_split, region2 );
+        delete subQuery;
+
+        TS_ASSERT( _workload->empty() );
+
+        _engine->numHandedOffSubtrees = 0;
+        _engine->openRegions.clear();
+    }
 };
 
 //
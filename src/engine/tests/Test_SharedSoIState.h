@@ -0,0 +1,92 @@
+/*********************                                                        */
+/*! \file Test_SharedSoIState.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Tests for the phase pattern and pseudo-impact scores that threads share
+ ** in parallel DeepSoI.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "SharedSoIState.h"
+
+class SharedSoIStateTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void test_phase_pattern()
+    {
+        SharedSoIState state( 2 );
+
+        unsigned version = 0;
+        Map<unsigned, PhaseStatus> pattern;
+        TS_ASSERT( !state.getPhasePattern( 1, version, pattern ) );
+
+        Map<unsigned, PhaseStatus> pattern1;
+        pattern1[0] = RELU_PHASE_ACTIVE;
+        pattern1[1] = RELU_PHASE_INACTIVE;
+        TS_ASSERT_EQUALS( state.publishPhasePattern( 0, pattern1 ), 1U );
+
+        // The publisher does not get its own pattern back
+        unsigned ownVersion = 0;
+        TS_ASSERT( !state.getPhasePattern( 0, ownVersion, pattern ) );
+        TS_ASSERT_EQUALS( ownVersion, 1U );
+        TS_ASSERT( pattern.empty() );
+
+        TS_ASSERT( state.getPhasePattern( 1, version, pattern ) );
+        TS_ASSERT_EQUALS( pattern, pattern1 );
+
+        // Nothing new
+        TS_ASSERT( !state.getPhasePattern( 1, version, pattern ) );
+
+        // A later pattern replaces the previous one, whatever its origin
+        Map<unsigned, PhaseStatus> pattern2;
+        pattern2[0] = RELU_PHASE_INACTIVE;
+        TS_ASSERT_EQUALS( state.publishPhasePattern( 1, pattern2 ), 2U );
+        TS_ASSERT( state.getPhasePattern( 0, ownVersion, pattern ) );
+        TS_ASSERT_EQUALS( pattern, pattern2 );
+        TS_ASSERT( !state.getPhasePattern( 1, version, pattern ) );
+    }
+
+    void test_exchange_scores()
+    {
+        SharedSoIState state( 2 );
+
+        Vector<double> scores0 = { 1, 2, 3 };
+        Vector<double> average;
+        state.exchangeScores( 0, scores0, average );
+        TS_ASSERT_EQUALS( average, scores0 );
+
+        Vector<double> scores1 = { 3, 4, 5 };
+        state.exchangeScores( 1, scores1, average );
+        Vector<double> expected = { 2, 3, 4 };
+        TS_ASSERT_EQUALS( average, expected );
+
+        // A new report replaces the previous one of the same worker
+        scores0 = { 5, 6, 7 };
+        state.exchangeScores( 0, scores0, average );
+        expected = { 4, 5, 6 };
+        TS_ASSERT_EQUALS( average, expected );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
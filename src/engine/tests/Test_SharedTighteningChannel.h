@@ -0,0 +1,156 @@
+/*********************                                                        */
+/*! \file Test_SharedTighteningChannel.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Tests for the channel through which DnC workers share level-0
+ ** tightenings, and for the containment test on SnC regions.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "SharedTighteningChannel.h"
+
+#include <thread>
+
+class SharedTighteningChannelTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void test_region_contains()
+    {
+        List<Tightening> outer;
+        outer.append( Tightening( 0, -1, Tightening::LB ) );
+        outer.append( Tightening( 0, 1, Tightening::UB ) );
+
+        List<Tightening> inner;
+        inner.append( Tightening( 0, 0, Tightening::LB ) );
+        inner.append( Tightening( 0, 1, Tightening::UB ) );
+        inner.append( Tightening( 1, 2, Tightening::UB ) );
+
+        TS_ASSERT( SharedTighteningChannel::regionContains( outer, inner ) );
+        TS_ASSERT( !SharedTighteningChannel::regionContains( inner, outer ) );
+
+        // The empty region is the whole domain
+        TS_ASSERT( SharedTighteningChannel::regionContains( List<Tightening>(), inner ) );
+        TS_ASSERT( !SharedTighteningChannel::regionContains( inner, List<Tightening>() ) );
+    }
+
+    void test_publish_and_collect()
+    {
+        SharedTighteningChannel channel( 3 );
+
+        SharedTighteningChannel::Region whole =
+            std::make_shared<const List<Tightening>>();
+        List<Tightening> left;
+        left.append( Tightening( 0, 0, Tightening::UB ) );
+        List<Tightening> right;
+        right.append( Tightening( 0, 0, Tightening::LB ) );
+        SharedTighteningChannel::Region leftRegion =
+            std::make_shared<const List<Tightening>>( left );
+
+        TS_ASSERT( channel.publish( Tightening( 1, 0, Tightening::LB ), whole ) );
+        TS_ASSERT( channel.publish( Tightening( 2, 5, Tightening::UB ), leftRegion ) );
+        TS_ASSERT_EQUALS( channel.getNumPublished(), 2U );
+
+        // A worker on the right half only sees the global tightening
+        unsigned rightCursor = 0;
+        List<Tightening> result;
+        channel.collect( rightCursor, right, result );
+        TS_ASSERT_EQUALS( rightCursor, 2U );
+        TS_ASSERT_EQUALS( result.size(), 1U );
+        TS_ASSERT( *result.begin() == Tightening( 1, 0, Tightening::LB ) );
+
+        // A worker on the left half sees both
+        unsigned leftCursor = 0;
+        result.clear();
+        channel.collect( leftCursor, left, result );
+        TS_ASSERT_EQUALS( result.size(), 2U );
+
+        // Nothing new since the last read
+        result.clear();
+        channel.collect( leftCursor, left, result );
+        TS_ASSERT( result.empty() );
+
+        // Capacity is respected, and saturation is reported once
+        TS_ASSERT( !channel.reportSaturation() );
+        TS_ASSERT( channel.publish( Tightening( 3, 1, Tightening::LB ), whole ) );
+        TS_ASSERT( !channel.publish( Tightening( 4, 1, Tightening::LB ), whole ) );
+        TS_ASSERT( channel.reportSaturation() );
+        TS_ASSERT( !channel.reportSaturation() );
+        TS_ASSERT_EQUALS( channel.getNumPublished(), 3U );
+        channel.collect( leftCursor, left, result );
+        TS_ASSERT_EQUALS( result.size(), 1U );
+        TS_ASSERT_EQUALS( leftCursor, 3U );
+    }
+
+    void test_tightest_bounds()
+    {
+        SharedTighteningChannel::TightestBounds bounds;
+        TS_ASSERT( bounds.empty() );
+
+        TS_ASSERT( bounds.update( Tightening( 0, 1, Tightening::LB ) ) );
+        TS_ASSERT( bounds.update( Tightening( 0, 5, Tightening::UB ) ) );
+
+        // Duplicates and looser bounds are rejected
+        TS_ASSERT( !bounds.update( Tightening( 0, 1, Tightening::LB ) ) );
+        TS_ASSERT( !bounds.update( Tightening( 0, 0, Tightening::LB ) ) );
+        TS_ASSERT( !bounds.update( Tightening( 0, 6, Tightening::UB ) ) );
+        TS_ASSERT( bounds.implies( Tightening( 0, -1, Tightening::LB ) ) );
+        TS_ASSERT( !bounds.implies( Tightening( 1, -1, Tightening::LB ) ) );
+
+        // Tighter bounds replace the old ones
+        TS_ASSERT( bounds.update( Tightening( 0, 2, Tightening::LB ) ) );
+        TS_ASSERT( bounds.update( Tightening( 0, 4, Tightening::UB ) ) );
+        TS_ASSERT_EQUALS( bounds.getLowerBounds().size(), 1U );
+        TS_ASSERT_EQUALS( bounds.getLowerBounds()[0], 2 );
+        TS_ASSERT_EQUALS( bounds.getUpperBounds()[0], 4 );
+
+        bounds.clear();
+        TS_ASSERT( bounds.empty() );
+    }
+
+    void test_concurrent_publish()
+    {
+        SharedTighteningChannel channel( 4000 );
+        SharedTighteningChannel::Region whole =
+            std::make_shared<const List<Tightening>>();
+
+        std::list<std::thread> threads;
+        for ( unsigned t = 0; t < 4; ++t )
+        {
+            threads.push_back( std::thread( [&channel, &whole, t]()
+            {
+                for ( unsigned i = 0; i < 1000; ++i )
+                    channel.publish( Tightening( t, i, Tightening::LB ), whole );
+            } ) );
+        }
+        for ( auto &thread : threads )
+            thread.join();
+
+        unsigned cursor = 0;
+        List<Tightening> result;
+        channel.collect( cursor, List<Tightening>(), result );
+        TS_ASSERT_EQUALS( result.size(), 4000U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -452,6 +452,124 @@ public:
         TS_ASSERT_EQUALS( *it, split4 );
     }
 
+    void test_donate_open_subtree()
+    {
+        SmtCore smtCore( engine );
+
+        List<PiecewiseLinearCaseSplit> splitPath;
+        TS_ASSERT( !smtCore.donateOpenSubtree( splitPath ) );
+
+        MockConstraint constraint;
+
+        PiecewiseLinearCaseSplit split1;
+        split1.storeBoundTightening( Tightening( 1, 3.0, Tightening::LB ) );
+        PiecewiseLinearCaseSplit split2;
+        split2.storeBoundTightening( Tightening( 1, 3.0, Tightening::UB ) );
+
+        constraint.nextSplits.append( split1 );
+        constraint.nextSplits.append( split2 );
+
+        for ( unsigned i = 0; i < ( unsigned ) Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ); ++i )
+            smtCore.reportViolatedConstraint( &constraint );
+
+        constraint.nextIsActive = true;
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+
+        MockConstraint constraint2;
+
+        PiecewiseLinearCaseSplit split3;
+        split3.storeBoundTightening( Tightening( 7, 3.0, Tightening::LB ) );
+        PiecewiseLinearCaseSplit split4;
+        split4.storeBoundTightening( Tightening( 7, 3.0, Tightening::UB ) );
+
+        constraint2.nextSplits.append( split3 );
+        constraint2.nextSplits.append( split4 );
+
+        for ( unsigned i = 0; i < ( unsigned ) Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ); ++i )
+            smtCore.reportViolatedConstraint( &constraint2 );
+
+        constraint2.nextIsActive = true;
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+
+        // The shallowest alternative goes first
+        TS_ASSERT( smtCore.donateOpenSubtree( splitPath ) );
+        TS_ASSERT_EQUALS( splitPath.size(), 1U );
+        TS_ASSERT_EQUALS( *splitPath.begin(), split2 );
+
+        // Then the alternative of the second split, below split1
+        TS_ASSERT( smtCore.donateOpenSubtree( splitPath ) );
+        TS_ASSERT_EQUALS( splitPath.size(), 2U );
+        auto it = splitPath.begin();
+        TS_ASSERT_EQUALS( *it, split1 );
+        ++it;
+        TS_ASSERT_EQUALS( *it, split4 );
+
+        TS_ASSERT( !smtCore.donateOpenSubtree( splitPath ) );
+        TS_ASSERT( splitPath.empty() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+
+        // Nothing is left to explore locally
+        TS_ASSERT( !smtCore.popSplit() );
+    }
+
+    void test_get_open_subtrees()
+    {
+        SmtCore smtCore( engine );
+
+        // At the root, the whole tree is open
+        List<List<PiecewiseLinearCaseSplit>> splitPaths;
+        smtCore.getOpenSubtrees( splitPaths );
+        TS_ASSERT_EQUALS( splitPaths.size(), 1U );
+        TS_ASSERT( splitPaths.begin()->empty() );
+
+        MockConstraint constraint;
+
+        PiecewiseLinearCaseSplit split1;
+        split1.storeBoundTightening( Tightening( 1, 3.0, Tightening::LB ) );
+        PiecewiseLinearCaseSplit split2;
+        split2.storeBoundTightening( Tightening( 1, 3.0, Tightening::UB ) );
+
+        constraint.nextSplits.append( split1 );
+        constraint.nextSplits.append( split2 );
+
+        for ( unsigned i = 0; i < ( unsigned ) Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ); ++i )
+            smtCore.reportViolatedConstraint( &constraint );
+
+        constraint.nextIsActive = true;
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+
+        MockConstraint constraint2;
+
+        PiecewiseLinearCaseSplit split3;
+        split3.storeBoundTightening( Tightening( 7, 3.0, Tightening::LB ) );
+        PiecewiseLinearCaseSplit split4;
+        split4.storeBoundTightening( Tightening( 7, 3.0, Tightening::UB ) );
+
+        constraint2.nextSplits.append( split3 );
+        constraint2.nextSplits.append( split4 );
+
+        for ( unsigned i = 0; i < ( unsigned ) Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ); ++i )
+            smtCore.reportViolatedConstraint( &constraint2 );
+
+        constraint2.nextIsActive = true;
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+
+        // The alternatives, each below its prefix, and the current path
+        smtCore.getOpenSubtrees( splitPaths );
+        TS_ASSERT_EQUALS( splitPaths.size(), 3U );
+
+        auto path = splitPaths.begin();
+        TS_ASSERT_EQUALS( *path, List<PiecewiseLinearCaseSplit>( { split2 } ) );
+        ++path;
+        TS_ASSERT_EQUALS( *path, List<PiecewiseLinearCaseSplit>( { split1, split4 } ) );
+        ++path;
+        TS_ASSERT_EQUALS( *path, List<PiecewiseLinearCaseSplit>( { split1, split3 } ) );
+
+        // Nothing was removed from the stack
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+    }
+
     void test_store_smt_state()
     {
         // ReLU(x0, x1)
@@ -0,0 +1,97 @@
+/*********************                                                        */
+/*! \file Test_SubtreeHandoff.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Tests for handing off unexplored subtrees to idle DnC workers.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "SubtreeHandoff.h"
+
+class SubtreeHandoffTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void test_merge_splits()
+    {
+        PiecewiseLinearCaseSplit region;
+        region.storeBoundTightening( Tightening( 0, -1, Tightening::LB ) );
+        region.storeBoundTightening( Tightening( 0, 1, Tightening::UB ) );
+
+        PiecewiseLinearCaseSplit split1;
+        split1.storeBoundTightening( Tightening( 3, 0, Tightening::LB ) );
+        PiecewiseLinearCaseSplit split2;
+        split2.storeBoundTightening( Tightening( 5, 0, Tightening::UB ) );
+        Equation equation;
+        equation.addAddend( 1, 2 );
+        equation.addAddend( -1, 4 );
+        equation.setScalar( 0 );
+        split2.addEquation( equation );
+
+        List<PiecewiseLinearCaseSplit> splitPath = { split1, split2 };
+
+        PiecewiseLinearCaseSplit merged;
+        SubtreeHandoff::mergeSplits( region, splitPath, merged );
+
+        PiecewiseLinearCaseSplit expected;
+        expected.storeBoundTightening( Tightening( 0, -1, Tightening::LB ) );
+        expected.storeBoundTightening( Tightening( 0, 1, Tightening::UB ) );
+        expected.storeBoundTightening( Tightening( 3, 0, Tightening::LB ) );
+        expected.storeBoundTightening( Tightening( 5, 0, Tightening::UB ) );
+        expected.addEquation( equation );
+        TS_ASSERT_EQUALS( merged, expected );
+    }
+
+    void test_hand_off()
+    {
+        WorkerQueue workload( 0 );
+        std::atomic_int numUnsolvedSubQueries( 1 );
+        SubtreeHandoff handoff( &workload, numUnsolvedSubQueries );
+
+        TS_ASSERT( !handoff.idleWorkersNeedWork() );
+        handoff.workerIsIdle();
+        TS_ASSERT( handoff.idleWorkersNeedWork() );
+
+        PiecewiseLinearCaseSplit split;
+        split.storeBoundTightening( Tightening( 3, 0, Tightening::LB ) );
+        List<PiecewiseLinearCaseSplit> splitPath = { split };
+        TS_ASSERT_THROWS_NOTHING( handoff.handOff( PiecewiseLinearCaseSplit(),
+                                                   splitPath, "1-t1" ) );
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 2 );
+
+        // The handed-off subquery is pending, so no more work is needed
+        TS_ASSERT( !handoff.idleWorkersNeedWork() );
+
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( workload.pop( subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1-t1" );
+        TS_ASSERT_EQUALS( *subQuery->_split, split );
+        TS_ASSERT_EQUALS( subQuery->_timeoutInSeconds, 0U );
+        delete subQuery;
+
+        handoff.workerIsBusy();
+        TS_ASSERT( !handoff.idleWorkersNeedWork() );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
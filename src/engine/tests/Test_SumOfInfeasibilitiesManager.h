@@ -382,6 +382,76 @@ public:
                           0u );
     }
 
+    void test_propose_phase_pattern()
+    {
+        InputQuery ipq;
+        Vector<PiecewiseLinearConstraint *> plConstraints;
+        MockTableau tableau;
+        createInputQuery( ipq, plConstraints, tableau );
+        ipq.getNetworkLevelReasoner()->setTableau( &tableau );
+        tableau.nextValues[0] = -1;
+        tableau.nextValues[1] = 1;
+        tableau.nextValues[2] = 1;
+        tableau.nextValues[3] = 2;
+        tableau.nextValues[4] = 2;
+        tableau.nextValues[5] = 2;
+        tableau.nextValues[6] = 2;
+        tableau.nextValues[7] = 2;
+        tableau.nextValues[8] = 0;
+        tableau.nextValues[9] = 0;
+
+        Options::get()->setString
+            ( Options::SOI_INITIALIZATION_STRATEGY, "input-assignment" );
+
+        std::unique_ptr<SumOfInfeasibilitiesManager> soiManager;
+        TS_ASSERT_THROWS_NOTHING
+            ( soiManager =
+              std::unique_ptr<SumOfInfeasibilitiesManager>
+              ( new SumOfInfeasibilitiesManager( ipq, tableau ) ) );
+
+        TS_ASSERT_THROWS_NOTHING( soiManager->initializePhasePattern() );
+
+        for ( const auto &plConstraint : plConstraints )
+        {
+            soiManager->setPhaseStatusInLastAcceptedPhasePattern
+                ( plConstraint, *( plConstraint->getAllCases().begin() ) );
+        }
+
+        // Nothing changes
+        Map<PiecewiseLinearConstraint *, PhaseStatus> pattern =
+            soiManager->getLastAcceptedPhaseStatuses();
+        TS_ASSERT( !soiManager->proposePhasePattern( pattern ) );
+        TS_ASSERT( soiManager->getConstraintsUpdatedInLastProposal().empty() );
+
+        // Flip the second relu. Constraints not in the SoI are ignored.
+        pattern.clear();
+        pattern[plConstraints[1]] = *(++( plConstraints[1]->getAllCases().begin() ) );
+        ReluConstraint notInSoI( 0, 1 );
+        pattern[&notInSoI] = RELU_PHASE_ACTIVE;
+        TS_ASSERT( soiManager->proposePhasePattern( pattern ) );
+
+        LinearExpression cost;
+        TS_ASSERT_THROWS_NOTHING( plConstraints[0]->getCostFunctionComponent
+                                  ( cost, *( plConstraints[0]->
+                                             getAllCases().begin() ) ) );
+        TS_ASSERT_THROWS_NOTHING( plConstraints[1]->getCostFunctionComponent
+                                  ( cost, *(++( plConstraints[1]->
+                                                getAllCases().begin() ) ) ) );
+        TS_ASSERT_THROWS_NOTHING( plConstraints[2]->getCostFunctionComponent
+                                  ( cost, *( plConstraints[2]->
+                                             getAllCases().begin() ) ) );
+        TS_ASSERT_THROWS_NOTHING( plConstraints[3]->getCostFunctionComponent
+                                  ( cost, *( plConstraints[3]->
+                                             getAllCases().begin() ) ) );
+        TS_ASSERT_EQUALS( cost, soiManager->getCurrentSoIPhasePattern() );
+
+        TS_ASSERT_EQUALS( soiManager->getConstraintsUpdatedInLastProposal().size(),
+                          1u );
+        TS_ASSERT_EQUALS( *soiManager->
+                          getConstraintsUpdatedInLastProposal().begin(),
+                          plConstraints[1] );
+    }
+
     void test_propose_phase_pattern_update_walksat()
     {
         InputQuery ipq;
@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file Test_ThreadPlacement.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Tests for the pinning of DnC worker threads, on synthetic NUMA
+ ** topologies.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "ThreadPlacement.h"
+
+class ThreadPlacementTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void test_parse_cpu_list()
+    {
+        List<unsigned> cpus;
+        ThreadPlacement::parseCPUList( "0-3,8,10-11\n", cpus );
+        List<unsigned> expected = { 0, 1, 2, 3, 8, 10, 11 };
+        TS_ASSERT_EQUALS( cpus, expected );
+
+        ThreadPlacement::parseCPUList( "5", cpus );
+        expected = { 5 };
+        TS_ASSERT_EQUALS( cpus, expected );
+
+        ThreadPlacement::parseCPUList( "", cpus );
+        TS_ASSERT( cpus.empty() );
+    }
+
+    void test_assign_cpus()
+    {
+        Vector<List<unsigned>> nodes;
+        nodes.append( List<unsigned>( { 0, 1, 2 } ) );
+        nodes.append( List<unsigned>( { 4, 5 } ) );
+
+        Vector<int> cpus;
+        ThreadPlacement::assignCPUs( nodes, ThreadPlacementPolicy::None, 3, cpus );
+        Vector<int> expected = { ThreadPlacement::NO_CPU, ThreadPlacement::NO_CPU,
+                                 ThreadPlacement::NO_CPU };
+        TS_ASSERT_EQUALS( cpus, expected );
+
+        ThreadPlacement::assignCPUs( nodes, ThreadPlacementPolicy::Compact, 4, cpus );
+        expected = { 0, 1, 2, 4 };
+        TS_ASSERT_EQUALS( cpus, expected );
+
+        ThreadPlacement::assignCPUs( nodes, ThreadPlacementPolicy::Scatter, 4, cpus );
+        expected = { 0, 4, 1, 5 };
+        TS_ASSERT_EQUALS( cpus, expected );
+
+        // More threads than cores
+        ThreadPlacement::assignCPUs( nodes, ThreadPlacementPolicy::Scatter, 7, cpus );
+        expected = { 0, 4, 1, 5, 2, 0, 4 };
+        TS_ASSERT_EQUALS( cpus, expected );
+
+        // No topology information
+        ThreadPlacement::assignCPUs( Vector<List<unsigned>>(),
+                                     ThreadPlacementPolicy::Compact, 2, cpus );
+        expected = { ThreadPlacement::NO_CPU, ThreadPlacement::NO_CPU };
+        TS_ASSERT_EQUALS( cpus, expected );
+    }
+
+    void test_assign_cpus_on_uneven_topology()
+    {
+        Vector<List<unsigned>> nodes;
+        nodes.append( List<unsigned>( { 0, 1, 2, 3 } ) );
+        nodes.append( List<unsigned>( { 8 } ) );
+        nodes.append( List<unsigned>( { 16, 17 } ) );
+
+        Vector<int> cpus;
+        ThreadPlacement::assignCPUs( nodes, ThreadPlacementPolicy::Compact, 6, cpus );
+        Vector<int> expected = { 0, 1, 2, 3, 8, 16 };
+        TS_ASSERT_EQUALS( cpus, expected );
+
+        // Exhausted nodes are skipped
+        ThreadPlacement::assignCPUs( nodes, ThreadPlacementPolicy::Scatter, 7, cpus );
+        expected = { 0, 8, 16, 1, 17, 2, 3 };
+        TS_ASSERT_EQUALS( cpus, expected );
+
+        // A single node
+        Vector<List<unsigned>> singleNode;
+        singleNode.append( List<unsigned>( { 2, 3 } ) );
+        ThreadPlacement::assignCPUs( singleNode, ThreadPlacementPolicy::Scatter, 3, cpus );
+        expected = { 2, 3, 2 };
+        TS_ASSERT_EQUALS( cpus, expected );
+        ThreadPlacement::assignCPUs( singleNode, ThreadPlacementPolicy::Compact, 3, cpus );
+        TS_ASSERT_EQUALS( cpus, expected );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -16,10 +16,135 @@
 #include "AcasNnet.h"
 #include "InputParserError.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
+//Reads the numbers of a .nnet file line by line, in fixed-size chunks,
+//so that lines of any length can be parsed without being copied first.
+//Numbers are parsed in place with strtod.
+class NnetStream
+{
+public:
+    NnetStream(FILE *fstream)
+        : fstream(fstream), begin(0), end(0), eof(false)
+    {
+        buffer[0] = '\0';
+    }
+
+    //Returns true if the whole file has been consumed
+    bool atEnd()
+    {
+        fill();
+        return begin == end;
+    }
+
+    //Returns true if the current line starts with "//"
+    bool atComment()
+    {
+        fill();
+        return end - begin >= 2 && buffer[begin] == '/' && buffer[begin+1] == '/';
+    }
+
+    //Reads the next number on the current line. Returns false if the
+    //line has no more numbers, in which case the stream stays on it.
+    bool readValue(double &value)
+    {
+        while (true)
+        {
+            fill();
+            if (begin == end || buffer[begin] == '\n')
+                return false;
+            char c = buffer[begin];
+            if (c != ',' && c != ' ' && c != '\t' && c != '\r')
+                break;
+            ++begin;
+        }
+
+        char *tokenEnd;
+        value = strtod(buffer + begin, &tokenEnd);
+        if (tokenEnd == buffer + begin)
+        {
+            //Not a number: treat it as 0, like atof would
+            value = 0;
+            while (begin < end && buffer[begin] != ',' && buffer[begin] != '\n')
+            {
+                ++begin;
+                fill();
+            }
+        }
+        else
+            begin = tokenEnd - buffer;
+        return true;
+    }
+
+    //Skips the rest of the current line, including the newline
+    void skipLine()
+    {
+        while (!atEnd())
+        {
+            char *newline = (char *)memchr(buffer + begin, '\n', end - begin);
+            if (newline != NULL)
+            {
+                begin = newline - buffer + 1;
+                return;
+            }
+            begin = end;
+        }
+    }
+
+private:
+    //Chunks are refilled while this many characters remain, which is
+    //more than any number in a .nnet file takes
+    static const size_t MAX_TOKEN_LENGTH = 128;
+    static const size_t CHUNK_SIZE = 1 << 20;
+
+    FILE *fstream;
+    char buffer[CHUNK_SIZE + 1];
+    size_t begin;
+    size_t end;
+    bool eof;
+
+    void fill()
+    {
+        if (eof || end - begin >= MAX_TOKEN_LENGTH)
+            return;
+
+        memmove(buffer, buffer + begin, end - begin);
+        end -= begin;
+        begin = 0;
+        size_t read = fread(buffer + end, 1, CHUNK_SIZE - end, fstream);
+        if (read == 0)
+            eof = true;
+        end += read;
+        //strtod stops at the terminator at the end of the chunk
+        buffer[end] = '\0';
+    }
+};
+
+//Reads the next line into values, which has room for size numbers.
+//Numbers beyond size are ignored, and missing numbers are left unchanged.
+static void read_line(NnetStream &stream, double *values, int size)
+{
+    double value;
+    int i = 0;
+    while (stream.readValue(value))
+    {
+        if (i < size)
+            values[i] = value;
+        ++i;
+    }
+    stream.skipLine();
+}
+
+static int read_int(NnetStream &stream)
+{
+    double value = 0;
+    stream.readValue(value);
+    return (int)value;
+}
+
 //Take in a .nnet filename with path and load the network from the file
 //Inputs:  filename - const char* that specifies the name and path of file
 //Outputs: void *   - points to the loaded neural network
@@ -34,74 +159,59 @@ AcasNnet *load_network(const char* filename)
     }
 
     //Initialize variables
-    int bufferSize = 40960;
-    char *buffer = new char[bufferSize];
-    char *record, *line;
-    int i=0, layer=0, row=0, j=0, param=0;
+    NnetStream *stream = new NnetStream(fstream);
+    int i=0, layer=0, row=0, param=0;
     AcasNnet *nnet = new AcasNnet();
 
     //Read int parameters of neural network
-    line=fgets(buffer,bufferSize,fstream);
-    while (strstr(line, "//")!=NULL)
-        line=fgets(buffer,bufferSize,fstream); //skip header lines
-    record = strtok(line,",\n");
-    nnet->numLayers    = atoi(record);
-    nnet->inputSize    = atoi(strtok(NULL,",\n"));
-    nnet->outputSize   = atoi(strtok(NULL,",\n"));
-    nnet->maxLayerSize = atoi(strtok(NULL,",\n"));
+    while (stream->atComment())
+        stream->skipLine(); //skip header lines
+    nnet->numLayers    = read_int(*stream);
+    nnet->inputSize    = read_int(*stream);
+    nnet->outputSize   = read_int(*stream);
+    nnet->maxLayerSize = read_int(*stream);
+    stream->skipLine();
+
+    if (nnet->numLayers <= 0 || nnet->inputSize <= 0 || nnet->outputSize <= 0)
+    {
+        delete stream;
+        fclose(fstream);
+        delete nnet;
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, filename );
+    }
 
     //Allocate space for and read values of the array members of the network
     nnet->layerSizes = new int[(((nnet->numLayers)+1))];
-    line = fgets(buffer,bufferSize,fstream);
-    record = strtok(line,",\n");
+    double *values = new double[nnet->numLayers+1];
+    std::fill(values, values + nnet->numLayers + 1, 0.0);
+    read_line(*stream, values, nnet->numLayers+1);
+    //The scratch arrays are sized by maxLayerSize, so do not trust the header
+    nnet->maxLayerSize = 0;
     for (i = 0; i<((nnet->numLayers)+1); i++)
     {
-        nnet->layerSizes[i] = atoi(record);
-        record = strtok(NULL,",\n");
+        nnet->layerSizes[i] = (int)values[i];
+        if (nnet->layerSizes[i] > nnet->maxLayerSize)
+            nnet->maxLayerSize = nnet->layerSizes[i];
     }
+    delete[] values;
 
     //Load the symmetric paramter
-    line = fgets(buffer,bufferSize,fstream);
-    record = strtok(line,",\n");
-    nnet->symmetric = atoi(record);
+    nnet->symmetric = read_int(*stream);
+    stream->skipLine();
 
     //Load Min and Max values of inputs
     nnet->mins = new double[(nnet->inputSize)];
-    line = fgets(buffer,bufferSize,fstream);
-    record = strtok(line,",\n");
-    for (i = 0; i<(nnet->inputSize); i++)
-    {
-        nnet->mins[i] = atof(record);
-        record = strtok(NULL,",\n");
-    }
+    read_line(*stream, nnet->mins, nnet->inputSize);
 
     nnet->maxes = new double[(nnet->inputSize)];
-    line = fgets(buffer,bufferSize,fstream);
-    record = strtok(line,",\n");
-    for (i = 0; i<(nnet->inputSize); i++)
-    {
-        nnet->maxes[i] = atof(record);
-        record = strtok(NULL,",\n");
-    }
+    read_line(*stream, nnet->maxes, nnet->inputSize);
 
     //Load Mean and Range of inputs
     nnet->means = new double[(((nnet->inputSize)+1))];
-    line = fgets(buffer,bufferSize,fstream);
-    record = strtok(line,",\n");
-    for (i = 0; i<((nnet->inputSize)+1); i++)
-    {
-        nnet->means[i] = atof(record);
-        record = strtok(NULL,",\n");
-    }
+    read_line(*stream, nnet->means, nnet->inputSize+1);
 
     nnet->ranges = new double[(((nnet->inputSize)+1))];
-    line = fgets(buffer,bufferSize,fstream);
-    record = strtok(line,",\n");
-    for (i = 0; i<((nnet->inputSize)+1); i++)
-    {
-        nnet->ranges[i] = atof(record);
-        record = strtok(NULL,",\n");
-    }
+    read_line(*stream, nnet->ranges, nnet->inputSize+1);
 
     //Allocate space for matrix of Neural Network
     //
@@ -113,16 +223,26 @@ AcasNnet *load_network(const char* filename)
     //Note that the bias array will have only number per neuron, so
     //    its fourth dimension will always be one
     //
+    //The rows of each layer share a single contiguous block, which is
+    //owned by the first row
+    //
     nnet->matrix = new double ***[((nnet->numLayers))];
     for (layer = 0; layer<(nnet->numLayers); layer++)
     {
+        int rows = nnet->layerSizes[layer+1];
+        int columns = nnet->layerSizes[layer];
         nnet->matrix[layer] = new double**[2];
-        nnet->matrix[layer][0] = new double*[nnet->layerSizes[layer+1]];
-        nnet->matrix[layer][1] = new double*[nnet->layerSizes[layer+1]];
-        for (row = 0; row<nnet->layerSizes[layer+1]; row++)
+        nnet->matrix[layer][0] = new double*[rows];
+        nnet->matrix[layer][1] = new double*[rows];
+        if (rows == 0)
+            continue;
+
+        double *weights = new double[(size_t)rows * columns]();
+        double *biases = new double[rows]();
+        for (row = 0; row<rows; row++)
         {
-            nnet->matrix[layer][0][row] = new double[nnet->layerSizes[layer]];
-            nnet->matrix[layer][1][row] = new double[1];
+            nnet->matrix[layer][0][row] = weights + (size_t)row * columns;
+            nnet->matrix[layer][1][row] = biases + row;
         }
     }
 
@@ -131,10 +251,9 @@ AcasNnet *load_network(const char* filename)
     layer = 0;
     param = 0;
     i=0;
-    j=0;
 
-    //Read in parameters and put them in the matrix
-    while((line=fgets(buffer,bufferSize,fstream))!=NULL)
+    //Read in parameters and put them in the matrix, one row per line
+    while(!stream->atEnd())
     {
         if(i>=nnet->layerSizes[layer+1])
         {
@@ -148,22 +267,19 @@ AcasNnet *load_network(const char* filename)
                 layer++;
             }
             i=0;
-            j=0;
         }
-        record = strtok(line,",\n");
-        while(record != NULL)
-        {
-            nnet->matrix[layer][param][i][j++] = atof(record);
-            record = strtok(NULL,",\n");
-        }
-        j=0;
+        if (layer >= nnet->numLayers)
+            break;
+
+        read_line(*stream, nnet->matrix[layer][param][i],
+                  param == 0 ? nnet->layerSizes[layer] : 1);
         i++;
     }
     nnet->inputs = new double[nnet->maxLayerSize];
     nnet->temp = new double[nnet->maxLayerSize];
 
 
-    delete[] buffer;
+    delete stream;
     fclose(fstream);
 
     //return a pointer to the neural network
@@ -175,17 +291,17 @@ AcasNnet *load_network(const char* filename)
 //Output:  void
 void destroy_network(AcasNnet *nnet)
 {
-    int i=0, row=0;
+    int i=0;
     if (nnet!=NULL)
     {
       // AcasNnet *nnet = static_cast<AcasNnet*>(network);
         for(i=0; i<(nnet->numLayers); i++)
         {
-            for(row=0;row<nnet->layerSizes[i+1];row++)
+            //free weight and bias arrays, which are owned by the first row
+            if (nnet->layerSizes[i+1] > 0)
             {
-                //free weight and bias arrays
-                delete[] nnet->matrix[i][0][row];
-                delete[] nnet->matrix[i][1][row];
+                delete[] nnet->matrix[i][0][0];
+                delete[] nnet->matrix[i][1][0];
             }
 
             //free pointer to weights and biases
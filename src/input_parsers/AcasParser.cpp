@@ -18,6 +18,7 @@
 #include "InputParserError.h"
 #include "InputQuery.h"
 #include "MString.h"
+#include "NetworkLevelReasoner.h"
 #include "ReluConstraint.h"
 
 AcasParser::NodeIndex::NodeIndex( unsigned layer, unsigned node )
@@ -115,10 +116,37 @@ void AcasParser::generateQuery( InputQuery &inputQuery )
         inputQuery.setUpperBound( fNode.second, FloatUtils::infinity() );
     }
 
-    // Next come the actual equations
+    // Next come the actual equations, and the ReLU constraints. The
+    // network level reasoner is constructed along the way, with the
+    // same layout InputQuery::constructNetworkLevelReasoner() would
+    // recover from the equations: an input layer, followed by
+    // alternating weighted sum and ReLU layers.
+    NLR::NetworkLevelReasoner *nlr = new NLR::NetworkLevelReasoner;
+    nlr->addLayer( 0, NLR::Layer::INPUT, inputLayerSize );
+    for ( unsigned i = 0; i < inputLayerSize; ++i )
+    {
+        unsigned fVar = _nodeToF[NodeIndex( 0, i )];
+        nlr->setNeuronVariable( NLR::NeuronIndex( 0, i ), fVar );
+        nlr->getLayer( 0 )->setLb( i, inputQuery.getLowerBound( fVar ) );
+        nlr->getLayer( 0 )->setUb( i, inputQuery.getUpperBound( fVar ) );
+    }
+
+    unsigned sourceNlrLayer = 0;
     for ( unsigned layer = 0; layer < numberOfLayers - 1; ++layer )
     {
+        unsigned sourceLayerSize = _acasNeuralNetwork.getLayerSize( layer );
         unsigned targetLayerSize = _acasNeuralNetwork.getLayerSize( layer + 1 );
+
+        unsigned weightedSumLayer = sourceNlrLayer + 1;
+        nlr->addLayer( weightedSumLayer, NLR::Layer::WEIGHTED_SUM, targetLayerSize );
+        nlr->addLayerDependency( sourceNlrLayer, weightedSumLayer );
+        NLR::Layer *nlrLayer = nlr->getLayer( weightedSumLayer );
+
+        // Look up the source variables once per layer, not once per edge
+        Vector<unsigned> fVars( sourceLayerSize );
+        for ( unsigned source = 0; source < sourceLayerSize; ++source )
+            fVars[source] = _nodeToF[NodeIndex( layer, source )];
+
         for ( unsigned target = 0; target < targetLayerSize; ++target )
         {
             // This will represent the equation:
@@ -128,35 +156,52 @@ void AcasParser::generateQuery( InputQuery &inputQuery )
             // The b variable
             unsigned bVar = _nodeToB[NodeIndex(layer + 1, target)];
             equation.addAddend( -1.0, bVar );
+            nlr->setNeuronVariable( NLR::NeuronIndex( weightedSumLayer, target ), bVar );
+            nlrLayer->setLb( target, FloatUtils::negativeInfinity() );
+            nlrLayer->setUb( target, FloatUtils::infinity() );
 
             // The f variables from the previous layer
-            for ( unsigned source = 0; source < _acasNeuralNetwork.getLayerSize( layer ); ++source )
+            for ( unsigned source = 0; source < sourceLayerSize; ++source )
             {
-                unsigned fVar = _nodeToF[NodeIndex(layer, source)];
-                equation.addAddend( _acasNeuralNetwork.getWeight( layer, source, target ), fVar );
+                double weight = _acasNeuralNetwork.getWeight( layer, source, target );
+                equation.addAddend( weight, fVars[source] );
+                nlr->setWeight( sourceNlrLayer, source, weightedSumLayer, target, weight );
             }
 
             // The bias
-            equation.setScalar( -_acasNeuralNetwork.getBias( layer + 1, target ) );
+            double bias = _acasNeuralNetwork.getBias( layer + 1, target );
+            equation.setScalar( -bias );
+            nlr->setBias( weightedSumLayer, target, bias );
 
             // Add the equation to the input query
             inputQuery.addEquation( equation );
         }
-    }
 
-    // Add the ReLU constraints
-    for ( unsigned i = 1; i < numberOfLayers - 1; ++i )
-    {
-        unsigned currentLayerSize = _acasNeuralNetwork.getLayerSize( i );
+        // The output layer has no ReLUs
+        if ( layer + 1 == numberOfLayers - 1 )
+            break;
 
-        for ( unsigned j = 0; j < currentLayerSize; ++j )
+        unsigned reluLayer = weightedSumLayer + 1;
+        nlr->addLayer( reluLayer, NLR::Layer::RELU, targetLayerSize );
+        nlr->addLayerDependency( weightedSumLayer, reluLayer );
+        nlrLayer = nlr->getLayer( reluLayer );
+
+        for ( unsigned j = 0; j < targetLayerSize; ++j )
         {
-            unsigned b = _nodeToB[NodeIndex(i, j)];
-            unsigned f = _nodeToF[NodeIndex(i, j)];
+            unsigned b = _nodeToB[NodeIndex(layer + 1, j)];
+            unsigned f = _nodeToF[NodeIndex(layer + 1, j)];
             PiecewiseLinearConstraint *relu = new ReluConstraint( b, f );
 
             inputQuery.addPiecewiseLinearConstraint( relu );
+            nlr->addConstraintInTopologicalOrder( relu );
+
+            nlr->setNeuronVariable( NLR::NeuronIndex( reluLayer, j ), f );
+            nlr->addActivationSource( weightedSumLayer, j, reluLayer, j );
+            nlrLayer->setLb( j, 0.0 );
+            nlrLayer->setUb( j, FloatUtils::infinity() );
         }
+
+        sourceNlrLayer = reluLayer;
     }
 
     // Mark the input and output variables
@@ -165,6 +210,11 @@ void AcasParser::generateQuery( InputQuery &inputQuery )
 
     for ( unsigned i = 0; i < outputLayerSize; ++i )
         inputQuery.markOutputVariable( _nodeToB[NodeIndex( numberOfLayers - 1, i )], i );
+
+    // Replace any previously constructed reasoner
+    if ( inputQuery.getNetworkLevelReasoner() )
+        delete inputQuery.getNetworkLevelReasoner();
+    inputQuery.setNetworkLevelReasoner( nlr );
 }
 
 unsigned AcasParser::getNumInputVaribales() const
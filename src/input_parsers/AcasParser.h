@@ -40,6 +40,11 @@ public:
     };
 
     AcasParser( const String &path );
+
+    /*
+      Encode the network in the input query, and construct its network
+      level reasoner in the same pass.
+    */
     void generateQuery( InputQuery &inputQuery );
 
     unsigned getNumInputVaribales() const;
@@ -0,0 +1,1626 @@
+/*********************                                                        */
+/*! \file OnnxParser.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The ONNX parser. The protobuf wire format is decoded by hand, keeping
+ ** only the fields of onnx.proto that describe a network; the graph is
+ ** then encoded node by node, tracking each tensor as a vector of affine
+ ** expressions that become variables only when an operator needs them.
+
+**/
+
+#include "Debug.h"
+#include "File.h"
+#include "FloatUtils.h"
+#include "InputParserError.h"
+#include "InputQuery.h"
+#include "MStringf.h"
+#include "MappedFile.h"
+#include "MaxConstraint.h"
+#include "NetworkLevelReasoner.h"
+#include "OnnxParser.h"
+#include "ReluConstraint.h"
+#include "Set.h"
+
+#include <cmath>
+#include <cstring>
+
+/*
+  The subset of onnx.proto that is needed to encode a network. Field
+  numbers are part of the ONNX format, and never change.
+*/
+namespace OnnxSchema
+{
+    enum ModelProto {
+        MODEL_GRAPH = 7,
+    };
+
+    enum GraphProto {
+        GRAPH_NODE = 1,
+        GRAPH_INITIALIZER = 5,
+        GRAPH_INPUT = 11,
+        GRAPH_OUTPUT = 12,
+    };
+
+    enum NodeProto {
+        NODE_INPUT = 1,
+        NODE_OUTPUT = 2,
+        NODE_OP_TYPE = 4,
+        NODE_ATTRIBUTE = 5,
+    };
+
+    enum AttributeProto {
+        ATTRIBUTE_NAME = 1,
+        ATTRIBUTE_FLOAT = 2,
+        ATTRIBUTE_INT = 3,
+        ATTRIBUTE_STRING = 4,
+        ATTRIBUTE_TENSOR = 5,
+        ATTRIBUTE_INTS = 8,
+    };
+
+    enum TensorProto {
+        TENSOR_DIMS = 1,
+        TENSOR_DATA_TYPE = 2,
+        TENSOR_FLOAT_DATA = 4,
+        TENSOR_INT32_DATA = 5,
+        TENSOR_INT64_DATA = 7,
+        TENSOR_NAME = 8,
+        TENSOR_RAW_DATA = 9,
+        TENSOR_DOUBLE_DATA = 10,
+    };
+
+    enum ValueInfoProto {
+        VALUE_INFO_NAME = 1,
+        VALUE_INFO_TYPE = 2,
+    };
+
+    // TypeProto.tensor_type, TypeProto.Tensor.shape, TensorShapeProto.dim
+    // and TensorShapeProto.Dimension.dim_value
+    enum TypeProto {
+        TYPE_TENSOR_TYPE = 1,
+        TENSOR_TYPE_SHAPE = 2,
+        SHAPE_DIM = 1,
+        DIM_VALUE = 1,
+    };
+
+    enum DataType {
+        FLOAT = 1,
+        INT32 = 6,
+        INT64 = 7,
+        DOUBLE = 11,
+    };
+}
+
+/*
+  Reads the fields of a protobuf message, in the wire format. Fixed-size
+  values are stored in little endian byte order, which is assumed to be
+  the byte order of the machine.
+*/
+class ProtobufReader
+{
+public:
+    enum WireType {
+        VARINT = 0,
+        FIXED64 = 1,
+        LENGTH_DELIMITED = 2,
+        FIXED32 = 5,
+    };
+
+    ProtobufReader( const char *data, unsigned long long size )
+        : _current( data )
+        , _end( data + size )
+        , _field( 0 )
+        , _wireType( 0 )
+    {
+    }
+
+    /*
+      Move to the next field. Returns false at the end of the message.
+    */
+    bool nextField()
+    {
+        if ( _current >= _end )
+            return false;
+
+        unsigned long long key = readVarint();
+        _field = key >> 3;
+        _wireType = key & 7;
+        return true;
+    }
+
+    unsigned field() const
+    {
+        return _field;
+    }
+
+    long long readInt()
+    {
+        expect( VARINT );
+        return (long long)readVarint();
+    }
+
+    double readFloat()
+    {
+        expect( FIXED32 );
+        return readFixed<float>();
+    }
+
+    ProtobufReader readMessage()
+    {
+        expect( LENGTH_DELIMITED );
+        unsigned long long length = readVarint();
+        require( length );
+        ProtobufReader message( _current, length );
+        _current += length;
+        return message;
+    }
+
+    String readString()
+    {
+        ProtobufReader bytes = readMessage();
+        return String( bytes._current, bytes._end - bytes._current );
+    }
+
+    /*
+      Repeated numbers are either packed into a single length delimited
+      field, or stored as one field per number
+    */
+    void readInts( Vector<long long> &values )
+    {
+        if ( _wireType != LENGTH_DELIMITED )
+        {
+            values.append( readInt() );
+            return;
+        }
+
+        ProtobufReader packed = readMessage();
+        while ( packed._current < packed._end )
+            values.append( (long long)packed.readVarint() );
+    }
+
+    template<typename T>
+    void readNumbers( Vector<double> &values )
+    {
+        if ( _wireType != LENGTH_DELIMITED )
+        {
+            expect( sizeof( T ) == 4 ? FIXED32 : FIXED64 );
+            values.append( readFixed<T>() );
+            return;
+        }
+
+        ProtobufReader packed = readMessage();
+        while ( packed._current < packed._end )
+            values.append( packed.readFixed<T>() );
+    }
+
+    void skip()
+    {
+        switch ( _wireType )
+        {
+        case VARINT:
+            readVarint();
+            break;
+
+        case FIXED64:
+            require( 8 );
+            _current += 8;
+            break;
+
+        case LENGTH_DELIMITED:
+            readMessage();
+            break;
+
+        case FIXED32:
+            require( 4 );
+            _current += 4;
+            break;
+
+        default:
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT,
+                                    "Unsupported protobuf wire type in ONNX file" );
+        }
+    }
+
+    const char *data() const
+    {
+        return _current;
+    }
+
+    unsigned long long size() const
+    {
+        return _end - _current;
+    }
+
+private:
+    const char *_current;
+    const char *_end;
+    unsigned _field;
+    unsigned _wireType;
+
+    void require( unsigned long long bytes ) const
+    {
+        if ( (unsigned long long)( _end - _current ) < bytes )
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Truncated ONNX file" );
+    }
+
+    void expect( unsigned wireType ) const
+    {
+        if ( _wireType != wireType )
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT,
+                                    "Unexpected protobuf wire type in ONNX file" );
+    }
+
+    unsigned long long readVarint()
+    {
+        unsigned long long value = 0;
+        for ( unsigned shift = 0; shift < 64; shift += 7 )
+        {
+            require( 1 );
+            unsigned char byte = *_current++;
+            value |= (unsigned long long)( byte & 0x7f ) << shift;
+            if ( !( byte & 0x80 ) )
+                return value;
+        }
+
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Malformed varint in ONNX file" );
+    }
+
+    template<typename T>
+    T readFixed()
+    {
+        require( sizeof( T ) );
+        T value;
+        memcpy( &value, _current, sizeof( T ) );
+        _current += sizeof( T );
+        return value;
+    }
+};
+
+/*
+  Repeatedly reads the fields of a message, skipping unknown ones
+*/
+static Vector<unsigned> parseShape( ProtobufReader reader )
+{
+    Vector<unsigned> shape;
+    while ( reader.nextField() )
+    {
+        if ( reader.field() != OnnxSchema::SHAPE_DIM )
+        {
+            reader.skip();
+            continue;
+        }
+
+        // Symbolic dimensions, e.g. the batch size, are taken to be 1
+        unsigned value = 1;
+        ProtobufReader dimension = reader.readMessage();
+        while ( dimension.nextField() )
+        {
+            if ( dimension.field() == OnnxSchema::DIM_VALUE )
+                value = dimension.readInt();
+            else
+                dimension.skip();
+        }
+        shape.append( value );
+    }
+    return shape;
+}
+
+OnnxParser::OnnxParser( const String &path )
+    : _numberOfVariables( 0 )
+    , _numberOfLayers( 0 )
+    , _nlr( NULL )
+{
+    if ( !File::exists( path ) )
+        throw InputParserError( InputParserError::FILE_DOESNT_EXIST, path.ascii() );
+
+    MappedFile file( path );
+    parseModel( ProtobufReader( file.data(), file.size() ) );
+}
+
+bool OnnxParser::isOnnxFile( const String &path )
+{
+    return path.length() >= 5 && path.substring( path.length() - 5, 5 ) == ".onnx";
+}
+
+void OnnxParser::parseModel( ProtobufReader reader )
+{
+    bool foundGraph = false;
+    while ( reader.nextField() )
+    {
+        if ( reader.field() == OnnxSchema::MODEL_GRAPH )
+        {
+            parseGraph( reader.readMessage() );
+            foundGraph = true;
+        }
+        else
+            reader.skip();
+    }
+
+    if ( !foundGraph )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, "ONNX model has no graph" );
+}
+
+void OnnxParser::parseGraph( ProtobufReader reader )
+{
+    List<ValueInfo> inputs;
+    while ( reader.nextField() )
+    {
+        switch ( reader.field() )
+        {
+        case OnnxSchema::GRAPH_NODE:
+            _nodes.append( parseNode( reader.readMessage() ) );
+            break;
+
+        case OnnxSchema::GRAPH_INITIALIZER:
+        {
+            String name;
+            ConstantTensor tensor = parseTensor( reader.readMessage(), name );
+            _constants[name] = tensor;
+            break;
+        }
+
+        case OnnxSchema::GRAPH_INPUT:
+            inputs.append( parseValueInfo( reader.readMessage() ) );
+            break;
+
+        case OnnxSchema::GRAPH_OUTPUT:
+            _outputs.append( parseValueInfo( reader.readMessage() )._name );
+            break;
+
+        default:
+            reader.skip();
+        }
+    }
+
+    // Older exporters also list the initializers as graph inputs
+    for ( const auto &input : inputs )
+    {
+        if ( !_constants.exists( input._name ) )
+            _inputs.append( input );
+    }
+}
+
+OnnxParser::Node OnnxParser::parseNode( ProtobufReader reader )
+{
+    Node node;
+    while ( reader.nextField() )
+    {
+        switch ( reader.field() )
+        {
+        case OnnxSchema::NODE_INPUT:
+            node._inputs.append( reader.readString() );
+            break;
+
+        case OnnxSchema::NODE_OUTPUT:
+            node._outputs.append( reader.readString() );
+            break;
+
+        case OnnxSchema::NODE_OP_TYPE:
+            node._opType = reader.readString();
+            break;
+
+        case OnnxSchema::NODE_ATTRIBUTE:
+        {
+            String name;
+            Attribute attribute = parseAttribute( reader.readMessage(), name );
+            node._attributes[name] = attribute;
+            break;
+        }
+
+        default:
+            reader.skip();
+        }
+    }
+    return node;
+}
+
+OnnxParser::Attribute OnnxParser::parseAttribute( ProtobufReader reader, String &name )
+{
+    Attribute attribute;
+    while ( reader.nextField() )
+    {
+        switch ( reader.field() )
+        {
+        case OnnxSchema::ATTRIBUTE_NAME:
+            name = reader.readString();
+            break;
+
+        case OnnxSchema::ATTRIBUTE_FLOAT:
+            attribute._float = reader.readFloat();
+            break;
+
+        case OnnxSchema::ATTRIBUTE_INT:
+            attribute._int = reader.readInt();
+            break;
+
+        case OnnxSchema::ATTRIBUTE_STRING:
+            attribute._string = reader.readString();
+            break;
+
+        case OnnxSchema::ATTRIBUTE_TENSOR:
+        {
+            String tensorName;
+            attribute._tensor = parseTensor( reader.readMessage(), tensorName );
+            break;
+        }
+
+        case OnnxSchema::ATTRIBUTE_INTS:
+            reader.readInts( attribute._ints );
+            break;
+
+        default:
+            reader.skip();
+        }
+    }
+    return attribute;
+}
+
+OnnxParser::ConstantTensor OnnxParser::parseTensor( ProtobufReader reader, String &name )
+{
+    ConstantTensor tensor;
+    long long dataType = OnnxSchema::FLOAT;
+    Vector<long long> dimensions;
+    Vector<long long> integers;
+    const char *rawData = NULL;
+    unsigned long long rawSize = 0;
+
+    while ( reader.nextField() )
+    {
+        switch ( reader.field() )
+        {
+        case OnnxSchema::TENSOR_DIMS:
+            reader.readInts( dimensions );
+            break;
+
+        case OnnxSchema::TENSOR_DATA_TYPE:
+            dataType = reader.readInt();
+            break;
+
+        case OnnxSchema::TENSOR_FLOAT_DATA:
+            reader.readNumbers<float>( tensor._values );
+            break;
+
+        case OnnxSchema::TENSOR_DOUBLE_DATA:
+            reader.readNumbers<double>( tensor._values );
+            break;
+
+        case OnnxSchema::TENSOR_INT32_DATA:
+        case OnnxSchema::TENSOR_INT64_DATA:
+            reader.readInts( integers );
+            break;
+
+        case OnnxSchema::TENSOR_NAME:
+            name = reader.readString();
+            break;
+
+        case OnnxSchema::TENSOR_RAW_DATA:
+        {
+            ProtobufReader raw = reader.readMessage();
+            rawData = raw.data();
+            rawSize = raw.size();
+            break;
+        }
+
+        default:
+            reader.skip();
+        }
+    }
+
+    for ( const auto &dimension : dimensions )
+        tensor._shape.append( (unsigned)dimension );
+
+    for ( const auto &integer : integers )
+        tensor._values.append( (double)integer );
+
+    if ( rawData )
+    {
+        switch ( dataType )
+        {
+        case OnnxSchema::FLOAT:
+            for ( unsigned i = 0; i < rawSize / sizeof( float ); ++i )
+            {
+                float value;
+                memcpy( &value, rawData + i * sizeof( float ), sizeof( float ) );
+                tensor._values.append( value );
+            }
+            break;
+
+        case OnnxSchema::DOUBLE:
+            for ( unsigned i = 0; i < rawSize / sizeof( double ); ++i )
+            {
+                double value;
+                memcpy( &value, rawData + i * sizeof( double ), sizeof( double ) );
+                tensor._values.append( value );
+            }
+            break;
+
+        case OnnxSchema::INT32:
+            for ( unsigned i = 0; i < rawSize / sizeof( int32_t ); ++i )
+            {
+                int32_t value;
+                memcpy( &value, rawData + i * sizeof( int32_t ), sizeof( int32_t ) );
+                tensor._values.append( value );
+            }
+            break;
+
+        case OnnxSchema::INT64:
+            for ( unsigned i = 0; i < rawSize / sizeof( int64_t ); ++i )
+            {
+                int64_t value;
+                memcpy( &value, rawData + i * sizeof( int64_t ), sizeof( int64_t ) );
+                tensor._values.append( (double)value );
+            }
+            break;
+
+        default:
+            throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                    Stringf( "Tensor %s has unsupported data type %lld",
+                                             name.ascii(), dataType ).ascii() );
+        }
+    }
+
+    if ( tensor._values.size() != size( tensor._shape ) )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT,
+                                Stringf( "Tensor %s has %u values, but its shape has %u",
+                                         name.ascii(),
+                                         tensor._values.size(),
+                                         size( tensor._shape ) ).ascii() );
+
+    return tensor;
+}
+
+OnnxParser::ValueInfo OnnxParser::parseValueInfo( ProtobufReader reader )
+{
+    ValueInfo info;
+    while ( reader.nextField() )
+    {
+        if ( reader.field() == OnnxSchema::VALUE_INFO_NAME )
+        {
+            info._name = reader.readString();
+        }
+        else if ( reader.field() == OnnxSchema::VALUE_INFO_TYPE )
+        {
+            ProtobufReader type = reader.readMessage();
+            while ( type.nextField() )
+            {
+                if ( type.field() != OnnxSchema::TYPE_TENSOR_TYPE )
+                {
+                    type.skip();
+                    continue;
+                }
+
+                ProtobufReader tensorType = type.readMessage();
+                while ( tensorType.nextField() )
+                {
+                    if ( tensorType.field() == OnnxSchema::TENSOR_TYPE_SHAPE )
+                        info._shape = parseShape( tensorType.readMessage() );
+                    else
+                        tensorType.skip();
+                }
+            }
+        }
+        else
+            reader.skip();
+    }
+    return info;
+}
+
+void OnnxParser::generateQuery( InputQuery &inputQuery )
+{
+    _tensors.clear();
+    _numberOfVariables = 0;
+    _variableToLayer.clear();
+    _variableToNeuron.clear();
+    _equations.clear();
+    _constraints.clear();
+    _inputVariables.clear();
+    _outputVariables.clear();
+    _nlr = new NLR::NetworkLevelReasoner;
+
+    try
+    {
+        // All inputs go in the input layer
+        unsigned inputLayerSize = 0;
+        for ( const auto &input : _inputs )
+            inputLayerSize += size( input._shape );
+
+        _nlr->addLayer( 0, NLR::Layer::INPUT, inputLayerSize );
+        _numberOfLayers = 1;
+
+        unsigned neuron = 0;
+        for ( const auto &input : _inputs )
+        {
+            VariableTensor &tensor = newTensor( input._name );
+            tensor._shape = input._shape;
+            for ( unsigned i = 0; i < size( input._shape ); ++i )
+            {
+                unsigned variable = newVariable( 0, neuron++ );
+                _inputVariables.append( variable );
+                tensor._elements.append( variableExpression( variable ) );
+            }
+        }
+
+        for ( const auto &node : _nodes )
+            processNode( node );
+
+        for ( const auto &output : _outputs )
+        {
+            VariableTensor &tensor = getTensor( output );
+            materialize( tensor );
+            for ( const auto &element : tensor._elements )
+                _outputVariables.append( element._variables[0] );
+        }
+    }
+    catch ( ... )
+    {
+        for ( const auto &constraint : _constraints )
+            delete constraint;
+        _constraints.clear();
+        delete _nlr;
+        _nlr = NULL;
+        throw;
+    }
+
+    printf( "Number of layers: %u. Input layer size: %u. Output layer size: %u. "
+            "Number of constraints: %u\n",
+            _numberOfLayers, _inputVariables.size(), _outputVariables.size(),
+            _constraints.size() );
+    printf( "Total number of variables: %u\n", _numberOfVariables );
+
+    inputQuery.setNumberOfVariables( _numberOfVariables );
+
+    for ( const auto &equation : _equations )
+        inputQuery.addEquation( equation );
+    _equations.clear();
+
+    for ( const auto &constraint : _constraints )
+        inputQuery.addPiecewiseLinearConstraint( constraint );
+    _constraints.clear();
+
+    for ( unsigned i = 0; i < _inputVariables.size(); ++i )
+        inputQuery.markInputVariable( _inputVariables[i], i );
+
+    for ( unsigned i = 0; i < _outputVariables.size(); ++i )
+        inputQuery.markOutputVariable( _outputVariables[i], i );
+
+    // The tensors are no longer needed
+    _tensors.clear();
+
+    if ( inputQuery.getNetworkLevelReasoner() )
+        delete inputQuery.getNetworkLevelReasoner();
+    inputQuery.setNetworkLevelReasoner( _nlr );
+    _nlr = NULL;
+}
+
+unsigned OnnxParser::getNumInputVariables() const
+{
+    return _inputVariables.size();
+}
+
+unsigned OnnxParser::getNumOutputVariables() const
+{
+    return _outputVariables.size();
+}
+
+unsigned OnnxParser::getInputVariable( unsigned index ) const
+{
+    if ( index >= _inputVariables.size() )
+        throw InputParserError( InputParserError::VARIABLE_INDEX_OUT_OF_RANGE );
+
+    return _inputVariables[index];
+}
+
+unsigned OnnxParser::getOutputVariable( unsigned index ) const
+{
+    if ( index >= _outputVariables.size() )
+        throw InputParserError( InputParserError::VARIABLE_INDEX_OUT_OF_RANGE );
+
+    return _outputVariables[index];
+}
+
+void OnnxParser::processNode( const Node &node )
+{
+    const String &opType = node._opType;
+
+    if ( node._outputs.empty() )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT,
+                                Stringf( "%s node has no outputs", opType.ascii() ).ascii() );
+
+    if ( opType == "Constant" )
+    {
+        if ( !node._attributes.exists( "value" ) )
+            throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                    "Constant nodes are supported only with a value tensor" );
+        _constants[node._outputs[0]] = node._attributes.at( "value" )._tensor;
+    }
+    else if ( opType == "Identity" || opType == "Dropout" )
+    {
+        if ( isConstant( node._inputs[0] ) )
+            _constants[node._outputs[0]] = getConstant( node._inputs[0] );
+        else
+            newTensor( node._outputs[0] ) = getTensor( node._inputs[0] );
+    }
+    else if ( opType == "Gemm" )
+        gemm( node );
+    else if ( opType == "MatMul" )
+        matMul( node );
+    else if ( opType == "Conv" )
+        conv( node );
+    else if ( opType == "BatchNormalization" )
+        batchNormalization( node );
+    else if ( opType == "Add" )
+        addOrSub( node, false );
+    else if ( opType == "Sub" )
+        addOrSub( node, true );
+    else if ( opType == "Relu" )
+        relu( node );
+    else if ( opType == "MaxPool" )
+        maxPool( node );
+    else if ( opType == "Flatten" )
+        flatten( node );
+    else if ( opType == "Reshape" )
+        reshape( node );
+    else if ( opType == "Transpose" )
+        transpose( node );
+    else
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION, opType.ascii() );
+}
+
+/*
+  Index into a tensor of shape fromShape that is broadcast, numpy style,
+  to shape, of the element at position index of the broadcast tensor
+*/
+static unsigned broadcastIndex( const Vector<unsigned> &fromShape,
+                                const Vector<unsigned> &shape,
+                                unsigned index )
+{
+    unsigned result = 0;
+    unsigned stride = 1;
+    int offset = (int)shape.size() - (int)fromShape.size();
+    for ( int dimension = shape.size() - 1; dimension >= 0 && dimension >= offset; --dimension )
+    {
+        unsigned coordinate = index % shape[dimension];
+        index /= shape[dimension];
+
+        unsigned fromSize = fromShape[dimension - offset];
+        if ( fromSize != 1 )
+            result += coordinate * stride;
+        stride *= fromSize;
+    }
+    return result;
+}
+
+static bool isBroadcastable( const Vector<unsigned> &fromShape, const Vector<unsigned> &shape )
+{
+    if ( fromShape.size() > shape.size() )
+        return false;
+
+    unsigned offset = shape.size() - fromShape.size();
+    for ( unsigned i = 0; i < fromShape.size(); ++i )
+    {
+        if ( fromShape[i] != 1 && fromShape[i] != shape[i + offset] )
+            return false;
+    }
+    return true;
+}
+
+void OnnxParser::gemm( const Node &node )
+{
+    // Y = alpha * A' * B' + beta * C, where ' is an optional transpose
+    VariableTensor &a = getTensor( node._inputs[0] );
+    const ConstantTensor &b = getConstant( node._inputs[1] );
+    materialize( a );
+
+    bool transA = getInt( node, "transA", 0 );
+    bool transB = getInt( node, "transB", 0 );
+    double alpha = getFloat( node, "alpha", 1.0 );
+    double beta = getFloat( node, "beta", 1.0 );
+
+    if ( a._shape.size() != 2 || b._shape.size() != 2 )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                "Gemm is supported only for matrices" );
+
+    unsigned m = transA ? a._shape[1] : a._shape[0];
+    unsigned k = transA ? a._shape[0] : a._shape[1];
+    unsigned n = transB ? b._shape[0] : b._shape[1];
+    if ( ( transB ? b._shape[1] : b._shape[0] ) != k )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Gemm shapes do not match" );
+
+    Vector<unsigned> outputShape = { m, n };
+    const ConstantTensor *c = NULL;
+    if ( node._inputs.size() > 2 && node._inputs[2] != "" )
+    {
+        c = &getConstant( node._inputs[2] );
+        if ( !isBroadcastable( c->_shape, outputShape ) )
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Gemm bias shape does not match" );
+    }
+
+    VariableTensor &output = newTensor( node._outputs[0] );
+    output._shape = outputShape;
+    output._elements = Vector<Expression>( m * n );
+
+    for ( unsigned row = 0; row < m; ++row )
+    {
+        for ( unsigned column = 0; column < n; ++column )
+        {
+            Expression &element = output._elements[row * n + column];
+            for ( unsigned i = 0; i < k; ++i )
+            {
+                double weight = alpha * b._values[transB ? column * k + i : i * n + column];
+                if ( weight == 0 )
+                    continue;
+
+                const Expression &source = a._elements[transA ? i * m + row : row * k + i];
+                element._variables.append( source._variables[0] );
+                element._coefficients.append( weight );
+            }
+
+            if ( c )
+                element._constant =
+                    beta * c->_values[broadcastIndex( c->_shape, outputShape, row * n + column )];
+        }
+    }
+}
+
+void OnnxParser::matMul( const Node &node )
+{
+    bool constantFirst = isConstant( node._inputs[0] );
+    if ( constantFirst == isConstant( node._inputs[1] ) )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                "MatMul is supported only between a variable and a constant tensor" );
+
+    VariableTensor &x = getTensor( node._inputs[constantFirst ? 1 : 0] );
+    const ConstantTensor &w = getConstant( node._inputs[constantFirst ? 0 : 1] );
+    materialize( x );
+
+    if ( x._shape.empty() || w._shape.empty() || w._shape.size() > 2 )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                "MatMul is supported only with a matrix or vector constant" );
+
+    VariableTensor &output = newTensor( node._outputs[0] );
+
+    if ( !constantFirst )
+    {
+        // X [..., k] times W [k, n], or W [k]
+        unsigned k = x._shape.last();
+        unsigned n = w._shape.size() == 2 ? w._shape[1] : 1;
+        if ( w._shape[0] != k )
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT, "MatMul shapes do not match" );
+
+        unsigned rows = size( x._shape ) / k;
+        for ( unsigned i = 0; i + 1 < x._shape.size(); ++i )
+            output._shape.append( x._shape[i] );
+        if ( w._shape.size() == 2 )
+            output._shape.append( n );
+
+        output._elements = Vector<Expression>( rows * n );
+        for ( unsigned row = 0; row < rows; ++row )
+        {
+            for ( unsigned column = 0; column < n; ++column )
+            {
+                Expression &element = output._elements[row * n + column];
+                for ( unsigned i = 0; i < k; ++i )
+                {
+                    double weight = w._values[i * n + column];
+                    if ( weight == 0 )
+                        continue;
+
+                    element._variables.append( x._elements[row * k + i]._variables[0] );
+                    element._coefficients.append( weight );
+                }
+            }
+        }
+    }
+    else
+    {
+        // W [m, k] times X [k, n], or X [k]
+        if ( w._shape.size() != 2 || x._shape.size() > 2 )
+            throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                    "MatMul is supported only with a matrix or vector constant" );
+
+        unsigned m = w._shape[0];
+        unsigned k = w._shape[1];
+        unsigned n = x._shape.size() == 2 ? x._shape[1] : 1;
+        if ( x._shape[0] != k )
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT, "MatMul shapes do not match" );
+
+        output._shape.append( m );
+        if ( x._shape.size() == 2 )
+            output._shape.append( n );
+
+        output._elements = Vector<Expression>( m * n );
+        for ( unsigned row = 0; row < m; ++row )
+        {
+            for ( unsigned column = 0; column < n; ++column )
+            {
+                Expression &element = output._elements[row * n + column];
+                for ( unsigned i = 0; i < k; ++i )
+                {
+                    double weight = w._values[row * k + i];
+                    if ( weight == 0 )
+                        continue;
+
+                    element._variables.append( x._elements[i * n + column]._variables[0] );
+                    element._coefficients.append( weight );
+                }
+            }
+        }
+    }
+}
+
+void OnnxParser::conv( const Node &node )
+{
+    // X [batch, channels, height, width], W [filters, channels / group, kernel height, kernel width]
+    VariableTensor &x = getTensor( node._inputs[0] );
+    const ConstantTensor &w = getConstant( node._inputs[1] );
+    materialize( x );
+
+    if ( x._shape.size() != 4 || w._shape.size() != 4 )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                "Conv is supported only for 2D convolutions" );
+
+    unsigned batch = x._shape[0];
+    unsigned channels = x._shape[1];
+    unsigned height = x._shape[2];
+    unsigned width = x._shape[3];
+    unsigned filters = w._shape[0];
+    unsigned groupChannels = w._shape[1];
+    unsigned group = getInt( node, "group", 1 );
+
+    if ( group == 0 || groupChannels * group != channels || filters % group != 0 )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Conv shapes do not match" );
+
+    const ConstantTensor *bias = NULL;
+    if ( node._inputs.size() > 2 && node._inputs[2] != "" )
+    {
+        bias = &getConstant( node._inputs[2] );
+        if ( bias->_values.size() != filters )
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Conv bias shape does not match" );
+    }
+
+    Vector<long long> kernel = { w._shape[2], w._shape[3] };
+    Vector<long long> strides = getInts( node, "strides", { 1, 1 } );
+    Vector<long long> dilations = getInts( node, "dilations", { 1, 1 } );
+    Vector<long long> pads;
+    computePadding( node, x._shape, kernel, strides, dilations, pads );
+
+    unsigned outputHeight = outputSize( height, kernel[0], strides[0], dilations[0], pads[0], pads[2], false );
+    unsigned outputWidth = outputSize( width, kernel[1], strides[1], dilations[1], pads[1], pads[3], false );
+
+    VariableTensor &output = newTensor( node._outputs[0] );
+    output._shape = { batch, filters, outputHeight, outputWidth };
+    output._elements = Vector<Expression>( size( output._shape ) );
+
+    unsigned filtersPerGroup = filters / group;
+    unsigned index = 0;
+    for ( unsigned b = 0; b < batch; ++b )
+    {
+        for ( unsigned filter = 0; filter < filters; ++filter )
+        {
+            unsigned firstChannel = ( filter / filtersPerGroup ) * groupChannels;
+            for ( unsigned row = 0; row < outputHeight; ++row )
+            {
+                for ( unsigned column = 0; column < outputWidth; ++column )
+                {
+                    Expression &element = output._elements[index++];
+                    element._constant = bias ? bias->_values[filter] : 0;
+
+                    for ( unsigned c = 0; c < groupChannels; ++c )
+                    {
+                        for ( long long i = 0; i < kernel[0]; ++i )
+                        {
+                            long long inputRow = row * strides[0] - pads[0] + i * dilations[0];
+                            if ( inputRow < 0 || inputRow >= height )
+                                continue;
+
+                            for ( long long j = 0; j < kernel[1]; ++j )
+                            {
+                                long long inputColumn = column * strides[1] - pads[1] + j * dilations[1];
+                                if ( inputColumn < 0 || inputColumn >= width )
+                                    continue;
+
+                                double weight =
+                                    w._values[( ( filter * groupChannels + c ) * kernel[0] + i ) * kernel[1] + j];
+                                if ( weight == 0 )
+                                    continue;
+
+                                unsigned source =
+                                    ( ( b * channels + firstChannel + c ) * height + inputRow ) * width + inputColumn;
+                                element._variables.append( x._elements[source]._variables[0] );
+                                element._coefficients.append( weight );
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void OnnxParser::batchNormalization( const Node &node )
+{
+    // Y = scale * ( X - mean ) / sqrt( variance + epsilon ) + B, per channel
+    const VariableTensor &x = getTensor( node._inputs[0] );
+    const ConstantTensor &scale = getConstant( node._inputs[1] );
+    const ConstantTensor &b = getConstant( node._inputs[2] );
+    const ConstantTensor &mean = getConstant( node._inputs[3] );
+    const ConstantTensor &variance = getConstant( node._inputs[4] );
+    double epsilon = getFloat( node, "epsilon", 1e-5 );
+
+    if ( x._shape.size() < 2 )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                "BatchNormalization is supported only with a channel dimension" );
+
+    unsigned channels = x._shape[1];
+    if ( scale._values.size() != channels || b._values.size() != channels ||
+         mean._values.size() != channels || variance._values.size() != channels )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT,
+                                "BatchNormalization shapes do not match" );
+
+    unsigned spatialSize = size( x._shape ) / ( x._shape[0] * channels );
+
+    VariableTensor &output = newTensor( node._outputs[0] );
+    output = x;
+    for ( unsigned i = 0; i < output._elements.size(); ++i )
+    {
+        unsigned channel = ( i / spatialSize ) % channels;
+        double factor = scale._values[channel] / std::sqrt( variance._values[channel] + epsilon );
+
+        Expression &element = output._elements[i];
+        for ( auto &coefficient : element._coefficients )
+            coefficient *= factor;
+        element._constant = factor * ( element._constant - mean._values[channel] ) + b._values[channel];
+    }
+}
+
+void OnnxParser::addOrSub( const Node &node, bool subtract )
+{
+    const String &first = node._inputs[0];
+    const String &second = node._inputs[1];
+    double sign = subtract ? -1 : 1;
+
+    if ( isConstant( first ) && isConstant( second ) )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                "Add and Sub are supported only with a variable tensor" );
+
+    if ( isConstant( first ) || isConstant( second ) )
+    {
+        // X + C, X - C, C + X or C - X
+        bool constantFirst = isConstant( first );
+        const VariableTensor &x = getTensor( constantFirst ? second : first );
+        const ConstantTensor &c = getConstant( constantFirst ? first : second );
+        if ( !isBroadcastable( c._shape, x._shape ) )
+            throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                    "Add and Sub are supported only if the output has the shape "
+                                    "of the variable tensor" );
+
+        double variableSign = constantFirst ? sign : 1;
+        double constantSign = constantFirst ? 1 : sign;
+
+        VariableTensor &output = newTensor( node._outputs[0] );
+        output = x;
+        for ( unsigned i = 0; i < output._elements.size(); ++i )
+        {
+            Expression &element = output._elements[i];
+            for ( auto &coefficient : element._coefficients )
+                coefficient *= variableSign;
+            element._constant = variableSign * element._constant +
+                constantSign * c._values[broadcastIndex( c._shape, x._shape, i )];
+        }
+        return;
+    }
+
+    VariableTensor &x = getTensor( first );
+    VariableTensor &y = getTensor( second );
+    if ( x._shape != y._shape )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                "Add and Sub of two variable tensors are supported only for equal shapes" );
+
+    /*
+      Keep one of the operands as an expression, and turn the other into
+      variables, so that each sum only adds a single term
+    */
+    bool keepFirst = false;
+    for ( const auto &element : x._elements )
+    {
+        if ( !element.isVariable() )
+        {
+            keepFirst = true;
+            break;
+        }
+    }
+
+    VariableTensor &kept = keepFirst ? x : y;
+    VariableTensor &other = keepFirst ? y : x;
+    materialize( other );
+
+    double keptSign = keepFirst ? 1 : sign;
+    double otherSign = keepFirst ? sign : 1;
+
+    VariableTensor &output = newTensor( node._outputs[0] );
+    output._shape = kept._shape;
+    output._elements = kept._elements;
+    for ( unsigned i = 0; i < output._elements.size(); ++i )
+    {
+        Expression &element = output._elements[i];
+        for ( auto &coefficient : element._coefficients )
+            coefficient *= keptSign;
+        element._constant *= keptSign;
+
+        unsigned variable = other._elements[i]._variables[0];
+        bool found = false;
+        for ( unsigned j = 0; j < element._variables.size(); ++j )
+        {
+            if ( element._variables[j] == variable )
+            {
+                element._coefficients[j] += otherSign;
+                found = true;
+                break;
+            }
+        }
+
+        if ( !found )
+        {
+            element._variables.append( variable );
+            element._coefficients.append( otherSign );
+        }
+    }
+}
+
+void OnnxParser::relu( const Node &node )
+{
+    VariableTensor &input = getTensor( node._inputs[0] );
+    materialize( input );
+
+    unsigned layer = _numberOfLayers++;
+    _nlr->addLayer( layer, NLR::Layer::RELU, input._elements.size() );
+
+    VariableTensor &output = newTensor( node._outputs[0] );
+    output._shape = input._shape;
+
+    for ( unsigned neuron = 0; neuron < input._elements.size(); ++neuron )
+    {
+        unsigned b = input._elements[neuron]._variables[0];
+        unsigned f = newVariable( layer, neuron );
+
+        ReluConstraint *relu = new ReluConstraint( b, f );
+        _constraints.append( relu );
+        _nlr->addConstraintInTopologicalOrder( relu );
+
+        _nlr->addLayerDependency( _variableToLayer[b], layer );
+        _nlr->addActivationSource( _variableToLayer[b], _variableToNeuron[b], layer, neuron );
+
+        output._elements.append( variableExpression( f ) );
+    }
+}
+
+void OnnxParser::maxPool( const Node &node )
+{
+    VariableTensor &x = getTensor( node._inputs[0] );
+    materialize( x );
+
+    if ( x._shape.size() != 4 )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                "MaxPool is supported only for 2D pooling" );
+
+    Vector<long long> kernel = getInts( node, "kernel_shape", Vector<long long>() );
+    if ( kernel.size() != 2 )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, "MaxPool has no 2D kernel shape" );
+
+    Vector<long long> strides = getInts( node, "strides", { 1, 1 } );
+    Vector<long long> dilations = getInts( node, "dilations", { 1, 1 } );
+    bool ceilMode = getInt( node, "ceil_mode", 0 );
+    Vector<long long> pads;
+    computePadding( node, x._shape, kernel, strides, dilations, pads );
+
+    unsigned batch = x._shape[0];
+    unsigned channels = x._shape[1];
+    unsigned height = x._shape[2];
+    unsigned width = x._shape[3];
+    unsigned outputHeight = outputSize( height, kernel[0], strides[0], dilations[0], pads[0], pads[2], ceilMode );
+    unsigned outputWidth = outputSize( width, kernel[1], strides[1], dilations[1], pads[1], pads[3], ceilMode );
+
+    VariableTensor &output = newTensor( node._outputs[0] );
+    output._shape = { batch, channels, outputHeight, outputWidth };
+
+    unsigned layer = _numberOfLayers++;
+    _nlr->addLayer( layer, NLR::Layer::MAX, size( output._shape ) );
+
+    unsigned neuron = 0;
+    for ( unsigned b = 0; b < batch; ++b )
+    {
+        for ( unsigned channel = 0; channel < channels; ++channel )
+        {
+            for ( unsigned row = 0; row < outputHeight; ++row )
+            {
+                for ( unsigned column = 0; column < outputWidth; ++column )
+                {
+                    // Padded positions never hold the maximum, so they are skipped
+                    Set<unsigned> elements;
+                    for ( long long i = 0; i < kernel[0]; ++i )
+                    {
+                        long long inputRow = row * strides[0] - pads[0] + i * dilations[0];
+                        if ( inputRow < 0 || inputRow >= height )
+                            continue;
+
+                        for ( long long j = 0; j < kernel[1]; ++j )
+                        {
+                            long long inputColumn = column * strides[1] - pads[1] + j * dilations[1];
+                            if ( inputColumn < 0 || inputColumn >= width )
+                                continue;
+
+                            unsigned source = ( ( b * channels + channel ) * height + inputRow ) * width + inputColumn;
+                            elements.insert( x._elements[source]._variables[0] );
+                        }
+                    }
+
+                    if ( elements.empty() )
+                        throw InputParserError( InputParserError::UNEXPECTED_INPUT,
+                                                "MaxPool window lies in the padding" );
+
+                    unsigned f = newVariable( layer, neuron );
+                    for ( const auto &element : elements )
+                    {
+                        _nlr->addLayerDependency( _variableToLayer[element], layer );
+                        _nlr->addActivationSource( _variableToLayer[element],
+                                                   _variableToNeuron[element],
+                                                   layer,
+                                                   neuron );
+                    }
+
+                    MaxConstraint *max = new MaxConstraint( f, elements );
+                    _constraints.append( max );
+                    _nlr->addConstraintInTopologicalOrder( max );
+
+                    output._elements.append( variableExpression( f ) );
+                    ++neuron;
+                }
+            }
+        }
+    }
+}
+
+void OnnxParser::flatten( const Node &node )
+{
+    const String &input = node._inputs[0];
+    Vector<unsigned> shape = isConstant( input ) ? getConstant( input )._shape : getTensor( input )._shape;
+
+    long long axis = getInt( node, "axis", 1 );
+    if ( axis < 0 )
+        axis += shape.size();
+    if ( axis < 0 || axis > (long long)shape.size() )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Flatten axis is out of range" );
+
+    unsigned outer = 1;
+    for ( long long i = 0; i < axis; ++i )
+        outer *= shape[i];
+    Vector<unsigned> outputShape = { outer, size( shape ) / ( outer == 0 ? 1 : outer ) };
+
+    if ( isConstant( input ) )
+    {
+        ConstantTensor output = getConstant( input );
+        output._shape = outputShape;
+        _constants[node._outputs[0]] = output;
+    }
+    else
+    {
+        VariableTensor &output = newTensor( node._outputs[0] );
+        output = getTensor( input );
+        output._shape = outputShape;
+    }
+}
+
+void OnnxParser::reshape( const Node &node )
+{
+    const String &input = node._inputs[0];
+    Vector<unsigned> shape = isConstant( input ) ? getConstant( input )._shape : getTensor( input )._shape;
+    const ConstantTensor &newShape = getConstant( node._inputs[1] );
+
+    // A 0 copies the dimension of the input, and a -1 is inferred
+    Vector<unsigned> outputShape;
+    int inferred = -1;
+    unsigned known = 1;
+    for ( unsigned i = 0; i < newShape._values.size(); ++i )
+    {
+        long long dimension = (long long)newShape._values[i];
+        if ( dimension == 0 && i < shape.size() )
+            dimension = shape[i];
+
+        if ( dimension == -1 )
+        {
+            inferred = i;
+            outputShape.append( 1 );
+        }
+        else if ( dimension < 0 )
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Invalid Reshape shape" );
+        else
+        {
+            outputShape.append( dimension );
+            known *= dimension;
+        }
+    }
+
+    if ( inferred >= 0 && known != 0 )
+        outputShape[inferred] = size( shape ) / known;
+
+    if ( size( outputShape ) != size( shape ) )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Reshape changes the number of elements" );
+
+    if ( isConstant( input ) )
+    {
+        ConstantTensor output = getConstant( input );
+        output._shape = outputShape;
+        _constants[node._outputs[0]] = output;
+    }
+    else
+    {
+        VariableTensor &output = newTensor( node._outputs[0] );
+        output = getTensor( input );
+        output._shape = outputShape;
+    }
+}
+
+void OnnxParser::transpose( const Node &node )
+{
+    const String &input = node._inputs[0];
+    Vector<unsigned> shape = isConstant( input ) ? getConstant( input )._shape : getTensor( input )._shape;
+
+    // The default permutation reverses the dimensions
+    Vector<long long> defaultPermutation;
+    for ( unsigned i = shape.size(); i > 0; --i )
+        defaultPermutation.append( i - 1 );
+    Vector<long long> permutation = getInts( node, "perm", defaultPermutation );
+
+    if ( permutation.size() != shape.size() )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Invalid Transpose permutation" );
+
+    Vector<unsigned> outputShape;
+    for ( unsigned i = 0; i < permutation.size(); ++i )
+    {
+        if ( permutation[i] < 0 || permutation[i] >= (long long)shape.size() )
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Invalid Transpose permutation" );
+        outputShape.append( shape[permutation[i]] );
+    }
+
+    // Row-major strides of the input, in the order of the output dimensions
+    Vector<unsigned> inputStrides( shape.size(), 1 );
+    for ( unsigned i = shape.size(); i > 1; --i )
+        inputStrides[i - 2] = inputStrides[i - 1] * shape[i - 1];
+
+    unsigned total = size( shape );
+    Vector<unsigned> sourceIndex( total, 0 );
+    for ( unsigned i = 0; i < total; ++i )
+    {
+        unsigned remainder = i;
+        for ( unsigned j = outputShape.size(); j > 0; --j )
+        {
+            unsigned coordinate = remainder % outputShape[j - 1];
+            remainder /= outputShape[j - 1];
+            sourceIndex[i] += coordinate * inputStrides[permutation[j - 1]];
+        }
+    }
+
+    if ( isConstant( input ) )
+    {
+        const ConstantTensor &x = getConstant( input );
+        ConstantTensor output;
+        output._shape = outputShape;
+        for ( unsigned i = 0; i < total; ++i )
+            output._values.append( x._values[sourceIndex[i]] );
+        _constants[node._outputs[0]] = output;
+    }
+    else
+    {
+        const VariableTensor &x = getTensor( input );
+        VariableTensor output;
+        output._shape = outputShape;
+        for ( unsigned i = 0; i < total; ++i )
+            output._elements.append( x._elements[sourceIndex[i]] );
+        newTensor( node._outputs[0] ) = output;
+    }
+}
+
+bool OnnxParser::Expression::isVariable() const
+{
+    return _variables.size() == 1 && _coefficients[0] == 1 && _constant == 0;
+}
+
+bool OnnxParser::isConstant( const String &name ) const
+{
+    return _constants.exists( name );
+}
+
+const OnnxParser::ConstantTensor &OnnxParser::getConstant( const String &name ) const
+{
+    if ( !_constants.exists( name ) )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                Stringf( "Tensor %s is expected to be a constant", name.ascii() ).ascii() );
+
+    return _constants.at( name );
+}
+
+OnnxParser::VariableTensor &OnnxParser::getTensor( const String &name )
+{
+    if ( !_tensors.exists( name ) )
+    {
+        if ( _constants.exists( name ) )
+            throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                    Stringf( "Tensor %s is expected to depend on the inputs",
+                                             name.ascii() ).ascii() );
+
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT,
+                                Stringf( "Unknown tensor %s", name.ascii() ).ascii() );
+    }
+
+    return _tensors[name];
+}
+
+OnnxParser::VariableTensor &OnnxParser::newTensor( const String &name )
+{
+    // References to other tensors remain valid, as the map is node based
+    VariableTensor &tensor = _tensors[name];
+    tensor = VariableTensor();
+    return tensor;
+}
+
+unsigned OnnxParser::newVariable( unsigned layer, unsigned neuron )
+{
+    unsigned variable = _numberOfVariables++;
+    _variableToLayer.append( layer );
+    _variableToNeuron.append( neuron );
+
+    _nlr->setNeuronVariable( NLR::NeuronIndex( layer, neuron ), variable );
+    _nlr->getLayer( layer )->setLb( neuron, FloatUtils::negativeInfinity() );
+    _nlr->getLayer( layer )->setUb( neuron, FloatUtils::infinity() );
+
+    return variable;
+}
+
+OnnxParser::Expression OnnxParser::variableExpression( unsigned variable ) const
+{
+    Expression expression;
+    expression._variables.append( variable );
+    expression._coefficients.append( 1 );
+    return expression;
+}
+
+void OnnxParser::materialize( VariableTensor &tensor )
+{
+    bool isMaterialized = true;
+    for ( const auto &element : tensor._elements )
+    {
+        if ( !element.isVariable() )
+        {
+            isMaterialized = false;
+            break;
+        }
+    }
+
+    if ( isMaterialized )
+        return;
+
+    // Each element becomes a neuron of a new weighted sum layer
+    unsigned layer = _numberOfLayers++;
+    _nlr->addLayer( layer, NLR::Layer::WEIGHTED_SUM, tensor._elements.size() );
+
+    for ( unsigned neuron = 0; neuron < tensor._elements.size(); ++neuron )
+    {
+        Expression &element = tensor._elements[neuron];
+        unsigned variable = newVariable( layer, neuron );
+
+        // sum( coefficients * variables ) - variable = -constant
+        Equation equation;
+        for ( unsigned i = 0; i < element._variables.size(); ++i )
+        {
+            unsigned source = element._variables[i];
+            double coefficient = element._coefficients[i];
+            equation.addAddend( coefficient, source );
+
+            _nlr->addLayerDependency( _variableToLayer[source], layer );
+            _nlr->setWeight( _variableToLayer[source], _variableToNeuron[source],
+                             layer, neuron, coefficient );
+        }
+        equation.addAddend( -1, variable );
+        equation.setScalar( -element._constant );
+        _equations.append( equation );
+
+        _nlr->setBias( layer, neuron, element._constant );
+
+        element = variableExpression( variable );
+    }
+}
+
+unsigned OnnxParser::size( const Vector<unsigned> &shape )
+{
+    unsigned result = 1;
+    for ( const auto &dimension : shape )
+        result *= dimension;
+    return result;
+}
+
+long long OnnxParser::getInt( const Node &node, const String &name, long long defaultValue )
+{
+    return node._attributes.exists( name ) ? node._attributes.at( name )._int : defaultValue;
+}
+
+double OnnxParser::getFloat( const Node &node, const String &name, double defaultValue )
+{
+    return node._attributes.exists( name ) ? node._attributes.at( name )._float : defaultValue;
+}
+
+Vector<long long> OnnxParser::getInts( const Node &node, const String &name,
+                                       const Vector<long long> &defaultValue )
+{
+    return node._attributes.exists( name ) ? node._attributes.at( name )._ints : defaultValue;
+}
+
+void OnnxParser::computePadding( const Node &node,
+                                 const Vector<unsigned> &inputShape,
+                                 const Vector<long long> &kernel,
+                                 const Vector<long long> &strides,
+                                 const Vector<long long> &dilations,
+                                 Vector<long long> &pads )
+{
+    if ( strides.size() != 2 || dilations.size() != 2 ||
+         strides[0] <= 0 || strides[1] <= 0 || dilations[0] <= 0 || dilations[1] <= 0 )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT,
+                                Stringf( "%s has invalid strides or dilations", node._opType.ascii() ).ascii() );
+
+    String autoPad = node._attributes.exists( "auto_pad" ) ?
+        node._attributes.at( "auto_pad" )._string : "NOTSET";
+
+    // Pads are ordered as [top, left, bottom, right]
+    pads = Vector<long long>( 4, 0 );
+    if ( autoPad == "NOTSET" )
+    {
+        Vector<long long> explicitPads = getInts( node, "pads", { 0, 0, 0, 0 } );
+        if ( explicitPads.size() != 4 )
+            throw InputParserError( InputParserError::UNEXPECTED_INPUT,
+                                    Stringf( "%s has invalid pads", node._opType.ascii() ).ascii() );
+        pads = explicitPads;
+    }
+    else if ( autoPad == "SAME_UPPER" || autoPad == "SAME_LOWER" )
+    {
+        // The output has ceil( input / stride ) elements in each dimension
+        for ( unsigned i = 0; i < 2; ++i )
+        {
+            long long input = inputShape[i + 2];
+            long long output = ( input + strides[i] - 1 ) / strides[i];
+            long long total = ( output - 1 ) * strides[i] + ( kernel[i] - 1 ) * dilations[i] + 1 - input;
+            if ( total < 0 )
+                total = 0;
+
+            long long smaller = total / 2;
+            pads[i] = autoPad == "SAME_UPPER" ? smaller : total - smaller;
+            pads[i + 2] = total - pads[i];
+        }
+    }
+    else if ( autoPad != "VALID" )
+        throw InputParserError( InputParserError::UNSUPPORTED_OPERATION,
+                                Stringf( "%s has unsupported auto_pad %s",
+                                         node._opType.ascii(), autoPad.ascii() ).ascii() );
+}
+
+unsigned OnnxParser::outputSize( unsigned inputSize, long long kernel, long long stride,
+                                 long long dilation, long long padBegin, long long padEnd,
+                                 bool ceilMode )
+{
+    long long span = inputSize + padBegin + padEnd - ( ( kernel - 1 ) * dilation + 1 );
+    if ( span < 0 )
+        throw InputParserError( InputParserError::UNEXPECTED_INPUT, "Kernel is larger than its input" );
+
+    return ( ceilMode ? ( span + stride - 1 ) / stride : span / stride ) + 1;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,213 @@
+/*********************                                                        */
+/*! \file OnnxParser.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A parser for neural networks stored in the ONNX format. The model is
+ ** decoded directly from the protobuf wire format, using the few fields
+ ** of onnx.proto that are needed to encode a network, and is then
+ ** encoded into an input query. The network level reasoner is
+ ** constructed along the way, so there is no need to recover it from
+ ** the equations afterwards.
+ **
+ ** Supported operators: Gemm, MatMul, Conv, BatchNormalization, Add, Sub,
+ ** Relu, MaxPool, Flatten, Reshape, Transpose, Identity, Dropout and
+ ** Constant.
+ ** Affine operators are folded together, so that e.g. MatMul followed
+ ** by Add becomes a single weighted sum layer.
+
+**/
+
+#ifndef __OnnxParser_h__
+#define __OnnxParser_h__
+
+#include "Equation.h"
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "Vector.h"
+
+class InputQuery;
+class PiecewiseLinearConstraint;
+class ProtobufReader;
+
+namespace NLR {
+class NetworkLevelReasoner;
+}
+
+class OnnxParser
+{
+public:
+    /*
+      Parse the model stored in a file. Throws an InputParserError if
+      the file is not a valid ONNX model.
+    */
+    OnnxParser( const String &path );
+
+    /*
+      Encode the network in the input query, and construct its network
+      level reasoner. Throws an InputParserError if the network uses an
+      unsupported operator.
+    */
+    void generateQuery( InputQuery &inputQuery );
+
+    unsigned getNumInputVariables() const;
+    unsigned getNumOutputVariables() const;
+    unsigned getInputVariable( unsigned index ) const;
+    unsigned getOutputVariable( unsigned index ) const;
+
+    /*
+      Whether a file should be parsed as an ONNX model, judging by its
+      extension.
+    */
+    static bool isOnnxFile( const String &path );
+
+private:
+    struct ConstantTensor
+    {
+        Vector<unsigned> _shape;
+        Vector<double> _values;
+    };
+
+    struct Attribute
+    {
+        Attribute()
+            : _int( 0 )
+            , _float( 0 )
+        {
+        }
+
+        long long _int;
+        double _float;
+        String _string;
+        Vector<long long> _ints;
+        ConstantTensor _tensor;
+    };
+
+    struct Node
+    {
+        String _opType;
+        Vector<String> _inputs;
+        Vector<String> _outputs;
+        Map<String, Attribute> _attributes;
+    };
+
+    struct ValueInfo
+    {
+        String _name;
+        Vector<unsigned> _shape;
+    };
+
+    /*
+      An affine combination of variables, sum( coefficients * variables )
+      + constant. Elements of a tensor stay expressions until an operator
+      needs them as variables.
+    */
+    struct Expression
+    {
+        Expression()
+            : _constant( 0 )
+        {
+        }
+
+        Vector<unsigned> _variables;
+        Vector<double> _coefficients;
+        double _constant;
+
+        bool isVariable() const;
+    };
+
+    struct VariableTensor
+    {
+        Vector<unsigned> _shape;
+        Vector<Expression> _elements;
+    };
+
+    /*
+      The parsed model
+    */
+    List<Node> _nodes;
+    Map<String, ConstantTensor> _constants;
+    List<ValueInfo> _inputs;
+    List<String> _outputs;
+
+    /*
+      State of the encoding
+    */
+    Map<String, VariableTensor> _tensors;
+    unsigned _numberOfVariables;
+    Vector<unsigned> _variableToLayer;
+    Vector<unsigned> _variableToNeuron;
+    unsigned _numberOfLayers;
+    NLR::NetworkLevelReasoner *_nlr;
+    List<Equation> _equations;
+    List<PiecewiseLinearConstraint *> _constraints;
+    Vector<unsigned> _inputVariables;
+    Vector<unsigned> _outputVariables;
+
+    /*
+      Decoding the protobuf messages
+    */
+    void parseModel( ProtobufReader reader );
+    void parseGraph( ProtobufReader reader );
+    Node parseNode( ProtobufReader reader );
+    Attribute parseAttribute( ProtobufReader reader, String &name );
+    ConstantTensor parseTensor( ProtobufReader reader, String &name );
+    ValueInfo parseValueInfo( ProtobufReader reader );
+
+    /*
+      Encoding the operators
+    */
+    void processNode( const Node &node );
+    void gemm( const Node &node );
+    void matMul( const Node &node );
+    void conv( const Node &node );
+    void batchNormalization( const Node &node );
+    void addOrSub( const Node &node, bool subtract );
+    void relu( const Node &node );
+    void maxPool( const Node &node );
+    void flatten( const Node &node );
+    void reshape( const Node &node );
+    void transpose( const Node &node );
+
+    /*
+      Helpers
+    */
+    bool isConstant( const String &name ) const;
+    const ConstantTensor &getConstant( const String &name ) const;
+    VariableTensor &getTensor( const String &name );
+    VariableTensor &newTensor( const String &name );
+
+    unsigned newVariable( unsigned layer, unsigned neuron );
+    void materialize( VariableTensor &tensor );
+    Expression variableExpression( unsigned variable ) const;
+
+    static unsigned size( const Vector<unsigned> &shape );
+    static long long getInt( const Node &node, const String &name, long long defaultValue );
+    static double getFloat( const Node &node, const String &name, double defaultValue );
+    static Vector<long long> getInts( const Node &node, const String &name,
+                                      const Vector<long long> &defaultValue );
+    static void computePadding( const Node &node,
+                                const Vector<unsigned> &inputShape,
+                                const Vector<long long> &kernel,
+                                const Vector<long long> &strides,
+                                const Vector<long long> &dilations,
+                                Vector<long long> &pads );
+    static unsigned outputSize( unsigned inputSize, long long kernel, long long stride,
+                                long long dilation, long long padBegin, long long padEnd,
+                                bool ceilMode );
+};
+
+#endif // __OnnxParser_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -14,19 +14,26 @@
  ** [[ Add lengthier description here ]]
  **/
 
+#include "AbsoluteValueConstraint.h"
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
 #include "Debug.h"
 #include "DisjunctionConstraint.h"
 #include "Equation.h"
 #include "GlobalConfiguration.h"
 #include "InputQuery.h"
 #include "MStringf.h"
+#include "MappedFile.h"
 #include "MarabouError.h"
 #include "MaxConstraint.h"
 #include "QueryLoader.h"
 #include "ReluConstraint.h"
+#include "SigmoidConstraint.h"
 #include "SignConstraint.h"
 
+#include <cstring>
+#include <fstream>
+
 InputQuery QueryLoader::loadQuery( const String &fileName )
 {
     if ( !IFile::exists( fileName ) )
@@ -34,6 +41,9 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
         throw MarabouError( MarabouError::FILE_DOES_NOT_EXIST, Stringf( "File %s not found.\n", fileName.ascii() ).ascii() );
     }
 
+    if ( isBinaryQuery( fileName ) )
+        return loadBinaryQuery( fileName );
+
     InputQuery inputQuery;
     AutoFile input( fileName );
     input->open( IFile::MODE_READ );
@@ -236,6 +246,244 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
     return inputQuery;
 }
 
+bool QueryLoader::isBinaryQuery( const String &fileName )
+{
+    std::ifstream file( fileName.ascii(), std::ios::binary );
+    char magic[sizeof( BinaryQueryFormat::MAGIC )];
+    return file.read( magic, sizeof( magic ) ) &&
+        memcmp( magic, BinaryQueryFormat::MAGIC, sizeof( magic ) ) == 0;
+}
+
+InputQuery QueryLoader::loadBinaryQuery( const String &fileName )
+{
+    if ( !IFile::exists( fileName ) )
+    {
+        throw MarabouError( MarabouError::FILE_DOES_NOT_EXIST, Stringf( "File %s not found.\n", fileName.ascii() ).ascii() );
+    }
+
+    MappedFile file( fileName );
+    const char *data = file.data();
+    unsigned long long size = file.size();
+    unsigned long long position = 0;
+
+    // Return a pointer to the next array of the given size, and move past
+    // it and its padding
+    auto next = [&]( unsigned long long bytes ) -> const char *
+    {
+        if ( bytes > size - position )
+            throw MarabouError( MarabouError::INVALID_BINARY_QUERY,
+                                Stringf( "%s is truncated\n", fileName.ascii() ).ascii() );
+        const char *result = data + position;
+        position = std::min( BinaryQueryFormat::alignedSize( position + bytes ), size );
+        return result;
+    };
+
+    BinaryQueryFormat::Header header;
+    memcpy( &header, next( sizeof( header ) ), sizeof( header ) );
+    if ( memcmp( header._magic, BinaryQueryFormat::MAGIC, sizeof( header._magic ) ) != 0 ||
+         header._byteOrderMark != BinaryQueryFormat::BYTE_ORDER_MARK )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY,
+                            Stringf( "%s is not a binary query of this machine\n", fileName.ascii() ).ascii() );
+    if ( header._version != BinaryQueryFormat::VERSION )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY,
+                            Stringf( "Unsupported binary query version: %u\n", header._version ).ascii() );
+
+    QL_LOG( Stringf( "Number of variables: %u\n", header._numberOfVariables ).ascii() );
+    QL_LOG( Stringf( "Number of equations: %u\n", header._numEquations ).ascii() );
+    QL_LOG( Stringf( "Number of addends: %u\n", header._numAddends ).ascii() );
+    QL_LOG( Stringf( "Number of non-linear constraints: %u\n", header._numConstraints ).ascii() );
+
+    // Variable indices are used to index arrays, so a corrupt index must
+    // not reach the engine
+    auto checkVariable = [&]( uint32_t variable ) -> uint32_t
+    {
+        if ( variable >= header._numberOfVariables )
+            throw MarabouError( MarabouError::INVALID_BINARY_QUERY,
+                                Stringf( "%s refers to variable %u, but has only %u variables\n",
+                                         fileName.ascii(), variable,
+                                         header._numberOfVariables ).ascii() );
+        return variable;
+    };
+
+    auto checkEquationType = [&]( uint32_t type ) -> Equation::EquationType
+    {
+        if ( type > Equation::LE )
+            throw MarabouError( MarabouError::INVALID_EQUATION_TYPE, Stringf( "Invalid Equation Type\n" ).ascii() );
+        return (Equation::EquationType)type;
+    };
+
+    InputQuery inputQuery;
+    inputQuery.setNumberOfVariables( header._numberOfVariables );
+
+    // Input and output variables
+    const uint32_t *inputVariables = (const uint32_t *)
+        next( header._numInputVariables * sizeof( uint32_t ) );
+    for ( unsigned i = 0; i < header._numInputVariables; ++i )
+        inputQuery.markInputVariable( checkVariable( inputVariables[i] ), i );
+
+    const uint32_t *outputVariables = (const uint32_t *)
+        next( header._numOutputVariables * sizeof( uint32_t ) );
+    for ( unsigned i = 0; i < header._numOutputVariables; ++i )
+        inputQuery.markOutputVariable( checkVariable( outputVariables[i] ), i );
+
+    // Bounds
+    const uint32_t *lowerBoundVariables = (const uint32_t *)
+        next( header._numLowerBounds * sizeof( uint32_t ) );
+    const double *lowerBoundValues = (const double *)
+        next( header._numLowerBounds * sizeof( double ) );
+    for ( unsigned i = 0; i < header._numLowerBounds; ++i )
+        inputQuery.setLowerBound( checkVariable( lowerBoundVariables[i] ), lowerBoundValues[i] );
+
+    const uint32_t *upperBoundVariables = (const uint32_t *)
+        next( header._numUpperBounds * sizeof( uint32_t ) );
+    const double *upperBoundValues = (const double *)
+        next( header._numUpperBounds * sizeof( double ) );
+    for ( unsigned i = 0; i < header._numUpperBounds; ++i )
+        inputQuery.setUpperBound( checkVariable( upperBoundVariables[i] ), upperBoundValues[i] );
+
+    // Equations
+    const uint32_t *equationTypes = (const uint32_t *)
+        next( header._numEquations * sizeof( uint32_t ) );
+    const double *equationScalars = (const double *)
+        next( header._numEquations * sizeof( double ) );
+    const uint32_t *equationOffsets = (const uint32_t *)
+        next( ( (unsigned long long)header._numEquations + 1 ) * sizeof( uint32_t ) );
+    const uint32_t *addendVariables = (const uint32_t *)
+        next( header._numAddends * sizeof( uint32_t ) );
+    const double *addendCoefficients = (const double *)
+        next( header._numAddends * sizeof( double ) );
+
+    for ( unsigned i = 0; i < header._numEquations; ++i )
+    {
+        if ( equationOffsets[i] > equationOffsets[i + 1] ||
+             equationOffsets[i + 1] > header._numAddends )
+            throw MarabouError( MarabouError::INVALID_BINARY_QUERY,
+                                Stringf( "Invalid addends of equation %u\n", i ).ascii() );
+
+        Equation equation( checkEquationType( equationTypes[i] ) );
+        equation.setScalar( equationScalars[i] );
+        for ( unsigned j = equationOffsets[i]; j < equationOffsets[i + 1]; ++j )
+            equation.addAddend( addendCoefficients[j], checkVariable( addendVariables[j] ) );
+
+        inputQuery.addEquation( equation );
+    }
+
+    // Non-linear constraints
+    for ( unsigned i = 0; i < header._numConstraints; ++i )
+    {
+        BinaryQueryFormat::ConstraintRecord record;
+        memcpy( &record, next( sizeof( record ) ), sizeof( record ) );
+        if ( record._numAuxVariables > 2 )
+            throw MarabouError( MarabouError::INVALID_BINARY_QUERY,
+                                Stringf( "Invalid auxiliary variables of constraint %u\n", i ).ascii() );
+        for ( unsigned j = 0; j < record._numAuxVariables; ++j )
+            checkVariable( record._aux[j] );
+
+        switch ( record._type )
+        {
+        case BinaryQueryFormat::RELU_CONSTRAINT:
+            checkVariable( record._b );
+            checkVariable( record._f );
+            if ( record._numAuxVariables == 1 )
+                inputQuery.addPiecewiseLinearConstraint
+                    ( new ReluConstraint( record._b, record._f, record._aux[0] ) );
+            else
+                inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( record._b, record._f ) );
+            break;
+
+        case BinaryQueryFormat::MAX_CONSTRAINT:
+        {
+            checkVariable( record._f );
+            const uint32_t *elementVariables = (const uint32_t *)
+                next( (unsigned long long)record._numElements * sizeof( uint32_t ) );
+            Set<unsigned> elements;
+            for ( unsigned j = 0; j < record._numElements; ++j )
+                elements.insert( checkVariable( elementVariables[j] ) );
+
+            if ( record._haveEliminatedPhases )
+                inputQuery.addPiecewiseLinearConstraint
+                    ( new MaxConstraint( record._f, elements, record._maxValueOfEliminatedPhases ) );
+            else
+                inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( record._f, elements ) );
+            break;
+        }
+
+        case BinaryQueryFormat::ABSOLUTE_VALUE_CONSTRAINT:
+            checkVariable( record._b );
+            checkVariable( record._f );
+            if ( record._numAuxVariables == 2 )
+                inputQuery.addPiecewiseLinearConstraint
+                    ( new AbsoluteValueConstraint( record._b, record._f,
+                                                   record._aux[0], record._aux[1] ) );
+            else
+                inputQuery.addPiecewiseLinearConstraint( new AbsoluteValueConstraint( record._b, record._f ) );
+            break;
+
+        case BinaryQueryFormat::SIGN_CONSTRAINT:
+            checkVariable( record._b );
+            checkVariable( record._f );
+            inputQuery.addPiecewiseLinearConstraint( new SignConstraint( record._b, record._f ) );
+            break;
+
+        case BinaryQueryFormat::DISJUNCTION_CONSTRAINT:
+        {
+            List<PiecewiseLinearCaseSplit> disjuncts;
+            for ( unsigned j = 0; j < record._numElements; ++j )
+            {
+                BinaryQueryFormat::DisjunctRecord disjunctRecord;
+                memcpy( &disjunctRecord, next( sizeof( disjunctRecord ) ), sizeof( disjunctRecord ) );
+
+                PiecewiseLinearCaseSplit disjunct;
+                for ( unsigned k = 0; k < disjunctRecord._numBounds; ++k )
+                {
+                    BinaryQueryFormat::BoundRecord boundRecord;
+                    memcpy( &boundRecord, next( sizeof( boundRecord ) ), sizeof( boundRecord ) );
+                    if ( boundRecord._type != Tightening::LB && boundRecord._type != Tightening::UB )
+                        throw MarabouError( MarabouError::INVALID_BINARY_QUERY,
+                                            Stringf( "Invalid bound type in constraint %u\n", i ).ascii() );
+                    disjunct.storeBoundTightening( Tightening( checkVariable( boundRecord._variable ),
+                                                              boundRecord._value,
+                                                              (Tightening::BoundType)boundRecord._type ) );
+                }
+
+                for ( unsigned k = 0; k < disjunctRecord._numEquations; ++k )
+                {
+                    BinaryQueryFormat::EquationRecord equationRecord;
+                    memcpy( &equationRecord, next( sizeof( equationRecord ) ), sizeof( equationRecord ) );
+
+                    Equation equation( checkEquationType( equationRecord._type ) );
+                    equation.setScalar( equationRecord._scalar );
+                    for ( unsigned l = 0; l < equationRecord._numAddends; ++l )
+                    {
+                        BinaryQueryFormat::AddendRecord addendRecord;
+                        memcpy( &addendRecord, next( sizeof( addendRecord ) ), sizeof( addendRecord ) );
+                        equation.addAddend( addendRecord._coefficient,
+                                            checkVariable( addendRecord._variable ) );
+                    }
+                    disjunct.addEquation( equation );
+                }
+
+                disjuncts.append( disjunct );
+            }
+            inputQuery.addPiecewiseLinearConstraint( new DisjunctionConstraint( disjuncts ) );
+            break;
+        }
+
+        case BinaryQueryFormat::SIGMOID_CONSTRAINT:
+            checkVariable( record._b );
+            checkVariable( record._f );
+            inputQuery.addTranscendentalConstraint( new SigmoidConstraint( record._b, record._f ) );
+            break;
+
+        default:
+            throw MarabouError( MarabouError::UNSUPPORTED_NON_LINEAR_CONSTRAINT, Stringf( "Unsupported non-linear constraint type: %u\n", record._type ).ascii() );
+        }
+    }
+
+    inputQuery.constructNetworkLevelReasoner();
+    return inputQuery;
+}
+
 
 //
 // Local Variables:
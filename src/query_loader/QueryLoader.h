@@ -29,9 +29,22 @@ public:
     unsigned _numConstraunsigneds;
 
     /*
-      Parse a serialized query and return it in InputQuery form
+      Parse a serialized query and return it in InputQuery form. Both the
+      text format and the binary format are accepted.
     */
     static InputQuery loadQuery( const String &fileName );
+
+    /*
+      Returns true if the file starts with the magic number of the binary
+      query format
+    */
+    static bool isBinaryQuery( const String &fileName );
+
+    /*
+      Load a query in the binary format (see BinaryQueryFormat.h). The file
+      is memory-mapped and its arrays are read in place.
+    */
+    static InputQuery loadBinaryQuery( const String &fileName );
 };
 
 #endif // __QueryLoader_h__
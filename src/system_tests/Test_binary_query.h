@@ -0,0 +1,231 @@
+/*********************                                                        */
+/*! \file Test_binary_query.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** System tests for the binary query format: queries are saved to files,
+ ** memory-mapped and loaded back, and corrupt files are rejected.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "AbsoluteValueConstraint.h"
+#include "AutoFile.h"
+#include "BinaryQueryFormat.h"
+#include "DisjunctionConstraint.h"
+#include "Equation.h"
+#include "FloatUtils.h"
+#include "InputQuery.h"
+#include "MappedFile.h"
+#include "MarabouError.h"
+#include "MaxConstraint.h"
+#include "QueryLoader.h"
+#include "ReluConstraint.h"
+#include "SigmoidConstraint.h"
+#include "SignConstraint.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+const String BINARY_QUERY_FILE( "Test_binary_query.mbq" );
+const String CORRUPT_BINARY_QUERY_FILE( "Test_binary_query.corrupt.mbq" );
+const String TEXT_QUERY_FILE( "Test_binary_query.ipq" );
+
+class BinaryQueryTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+        std::remove( BINARY_QUERY_FILE.ascii() );
+        std::remove( CORRUPT_BINARY_QUERY_FILE.ascii() );
+        std::remove( TEXT_QUERY_FILE.ascii() );
+    }
+
+    void populateQuery( InputQuery &inputQuery )
+    {
+        inputQuery.setNumberOfVariables( 12 );
+
+        inputQuery.markInputVariable( 1, 0 );
+        inputQuery.markInputVariable( 0, 1 );
+        inputQuery.markOutputVariable( 7, 0 );
+
+        inputQuery.setLowerBound( 0, -0.1 );
+        inputQuery.setUpperBound( 0, 1.0 / 3 );
+        inputQuery.setLowerBound( 1, 0 );
+        inputQuery.setUpperBound( 1, 1 );
+        inputQuery.setUpperBound( 7, FloatUtils::infinity() );
+
+        Equation equation1;
+        equation1.addAddend( 1, 0 );
+        equation1.addAddend( -2.5, 1 );
+        equation1.addAddend( -1, 2 );
+        equation1.setScalar( 0.125 );
+        inputQuery.addEquation( equation1 );
+
+        Equation equation2( Equation::GE );
+        equation2.addAddend( 1, 3 );
+        equation2.setScalar( -1 );
+        inputQuery.addEquation( equation2 );
+
+        // An equation without addends
+        inputQuery.addEquation( Equation( Equation::LE ) );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 2, 3 ) );
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 2, 8, 9 ) );
+        inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( 6, Set<unsigned>( { 3, 4, 5 } ) ) );
+        inputQuery.addPiecewiseLinearConstraint
+            ( new MaxConstraint( 10, Set<unsigned>( { 3, 4 } ), 1.0 / 7 ) );
+        inputQuery.addPiecewiseLinearConstraint( new AbsoluteValueConstraint( 1, 11 ) );
+        inputQuery.addPiecewiseLinearConstraint( new AbsoluteValueConstraint( 0, 11, 8, 9 ) );
+        inputQuery.addPiecewiseLinearConstraint( new SignConstraint( 4, 10 ) );
+
+        PiecewiseLinearCaseSplit disjunct1;
+        disjunct1.storeBoundTightening( Tightening( 4, 0.1, Tightening::UB ) );
+        Equation equation3( Equation::EQ );
+        equation3.addAddend( 1, 4 );
+        equation3.addAddend( -1, 5 );
+        equation3.setScalar( 1.0 / 3 );
+        disjunct1.addEquation( equation3 );
+        PiecewiseLinearCaseSplit disjunct2;
+        disjunct2.storeBoundTightening( Tightening( 4, 0.1, Tightening::LB ) );
+        disjunct2.storeBoundTightening( Tightening( 5, -1, Tightening::UB ) );
+        inputQuery.addPiecewiseLinearConstraint
+            ( new DisjunctionConstraint( List<PiecewiseLinearCaseSplit>( { disjunct1, disjunct2 } ) ) );
+
+        inputQuery.addTranscendentalConstraint( new SigmoidConstraint( 4, 5 ) );
+    }
+
+    void test_load_binary_query()
+    {
+        InputQuery inputQuery;
+        populateQuery( inputQuery );
+
+        inputQuery.saveBinaryQuery( BINARY_QUERY_FILE );
+        TS_ASSERT( QueryLoader::isBinaryQuery( BINARY_QUERY_FILE ) );
+
+        // loadQuery recognizes the binary format
+        InputQuery inputQuery2 = QueryLoader::loadQuery( BINARY_QUERY_FILE );
+
+        TS_ASSERT_EQUALS( inputQuery2.getNumberOfVariables(), 12U );
+        TS_ASSERT_EQUALS( inputQuery2.inputVariableByIndex( 0 ), 1U );
+        TS_ASSERT_EQUALS( inputQuery2.inputVariableByIndex( 1 ), 0U );
+        TS_ASSERT_EQUALS( inputQuery2.outputVariableByIndex( 0 ), 7U );
+        TS_ASSERT( inputQuery.getLowerBounds() == inputQuery2.getLowerBounds() );
+        TS_ASSERT( inputQuery.getUpperBounds() == inputQuery2.getUpperBounds() );
+        TS_ASSERT( inputQuery.getEquations() == inputQuery2.getEquations() );
+
+        const List<PiecewiseLinearConstraint *> &plConstraints = inputQuery.getPiecewiseLinearConstraints();
+        const List<PiecewiseLinearConstraint *> &plConstraints2 = inputQuery2.getPiecewiseLinearConstraints();
+        TS_ASSERT_EQUALS( plConstraints2.size(), 8U );
+        for ( auto it = plConstraints.begin(), it2 = plConstraints2.begin();
+              it != plConstraints.end() && it2 != plConstraints2.end();
+              ++it, ++it2 )
+        {
+            TS_ASSERT_EQUALS( (*it)->getType(), (*it2)->getType() );
+            TS_ASSERT_EQUALS( (*it)->serializeToString(), (*it2)->serializeToString() );
+        }
+
+        // The values of a disjunction and of eliminated Max phases are
+        // stored exactly
+        auto max = (const MaxConstraint *)*std::next( plConstraints2.begin(), 3 );
+        TS_ASSERT( max->haveFeasibleEliminatedPhases() );
+        TS_ASSERT_EQUALS( max->getMaxValueOfEliminatedPhases(), 1.0 / 7 );
+        TS_ASSERT( plConstraints.back()->getCaseSplits() ==
+                   plConstraints2.back()->getCaseSplits() );
+
+        TS_ASSERT_EQUALS( inputQuery2.getTranscendentalConstraints().size(), 1U );
+        TS_ASSERT_EQUALS( ( *inputQuery.getTranscendentalConstraints().begin() )->serializeToString(),
+                          ( *inputQuery2.getTranscendentalConstraints().begin() )->serializeToString() );
+
+        // Converting to the text format and back preserves the equations and
+        // bounds
+        inputQuery2.saveQuery( TEXT_QUERY_FILE );
+        TS_ASSERT( !QueryLoader::isBinaryQuery( TEXT_QUERY_FILE ) );
+        InputQuery inputQuery3 = QueryLoader::loadQuery( TEXT_QUERY_FILE );
+        TS_ASSERT( inputQuery.getEquations() == inputQuery3.getEquations() );
+        TS_ASSERT( inputQuery.getLowerBounds() == inputQuery3.getLowerBounds() );
+    }
+
+    void writeCorruptQuery( const String &contents )
+    {
+        AutoFile output( CORRUPT_BINARY_QUERY_FILE );
+        output->open( IFile::MODE_WRITE_TRUNCATE );
+        output->write( contents );
+    }
+
+    String readQuery()
+    {
+        MappedFile file( BINARY_QUERY_FILE );
+        return String( file.data(), file.size() );
+    }
+
+    void test_load_truncated_binary_query()
+    {
+        InputQuery inputQuery;
+        populateQuery( inputQuery );
+        inputQuery.saveBinaryQuery( BINARY_QUERY_FILE );
+        String contents = readQuery();
+
+        // Keep the header only, and then drop the last constraint only
+        writeCorruptQuery( contents.substring( 0, sizeof( BinaryQueryFormat::Header ) + 8 ) );
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( CORRUPT_BINARY_QUERY_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+
+        writeCorruptQuery( contents.substring( 0, contents.length() - 8 ) );
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( CORRUPT_BINARY_QUERY_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+    }
+
+    void test_load_binary_query_with_invalid_variable()
+    {
+        InputQuery inputQuery;
+        populateQuery( inputQuery );
+        inputQuery.saveBinaryQuery( BINARY_QUERY_FILE );
+        String contents = readQuery();
+
+        // The first input variable comes right after the header
+        std::string corrupt( contents.ascii(), contents.length() );
+        uint32_t variable = 12;
+        unsigned offset = BinaryQueryFormat::alignedSize( sizeof( BinaryQueryFormat::Header ) );
+        memcpy( &corrupt[offset], &variable, sizeof( variable ) );
+        writeCorruptQuery( String( corrupt.data(), corrupt.size() ) );
+
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( CORRUPT_BINARY_QUERY_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+
+        // So does a constraint over a variable out of range
+        InputQuery inputQuery2;
+        inputQuery2.setNumberOfVariables( 2 );
+        inputQuery2.addPiecewiseLinearConstraint( new ReluConstraint( 0, 2 ) );
+        inputQuery2.saveBinaryQuery( CORRUPT_BINARY_QUERY_FILE );
+
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( CORRUPT_BINARY_QUERY_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,112 @@
+/*********************                                                        */
+/*! \file Test_checkpoint.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** System tests for checkpoint files: round trips through the file
+ ** system, and rejection of truncated or mismatched checkpoints.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "AutoFile.h"
+#include "Checkpoint.h"
+#include "MarabouError.h"
+
+#include <cstdio>
+
+class CheckpointTestSuite : public CxxTest::TestSuite
+{
+public:
+    const char *checkpointFile = "Test_checkpoint.checkpoint";
+    const char *fingerprint = "0123456789abcdef";
+
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+        std::remove( checkpointFile );
+    }
+
+    void test_write_and_read()
+    {
+        PiecewiseLinearCaseSplit region1;
+        region1.storeBoundTightening( Tightening( 0, -0.1, Tightening::LB ) );
+        region1.storeBoundTightening( Tightening( 0, 1.0 / 3, Tightening::UB ) );
+
+        PiecewiseLinearCaseSplit region2;
+        region2.storeBoundTightening( Tightening( 4, 0, Tightening::UB ) );
+        Equation equation( Equation::GE );
+        equation.addAddend( 1, 2 );
+        equation.addAddend( -2.5, 5 );
+        equation.setScalar( -1e-9 );
+        region2.addEquation( equation );
+
+        List<PiecewiseLinearCaseSplit> regions = { region1, region2, PiecewiseLinearCaseSplit() };
+        List<Tightening> globalTightenings = { Tightening( 3, 0.25, Tightening::LB ) };
+
+        TS_ASSERT_THROWS_NOTHING( Checkpoint::write( checkpointFile, fingerprint, regions,
+                                                     globalTightenings ) );
+
+        List<PiecewiseLinearCaseSplit> readRegions;
+        List<Tightening> readTightenings;
+        TS_ASSERT_THROWS_NOTHING( Checkpoint::read( checkpointFile, fingerprint, readRegions,
+                                                    readTightenings ) );
+
+        // Values are restored exactly
+        TS_ASSERT_EQUALS( readRegions, regions );
+        TS_ASSERT_EQUALS( readTightenings.size(), 1U );
+        TS_ASSERT( *readTightenings.begin() == *globalTightenings.begin() );
+    }
+
+    void test_read_invalid()
+    {
+        List<PiecewiseLinearCaseSplit> regions;
+        List<Tightening> tightenings;
+
+        TS_ASSERT_THROWS_EQUALS( Checkpoint::read( checkpointFile, fingerprint, regions, tightenings ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::FILE_DOESNT_EXIST );
+
+        // A truncated checkpoint is rejected
+        {
+            AutoFile file( checkpointFile );
+            file->open( IFile::MODE_WRITE_TRUNCATE );
+            file->write( "marabou-checkpoint,2\n0123456789abcdef\n0\n2\n1,0\n0,l,1\n" );
+        }
+        TS_ASSERT_THROWS_EQUALS( Checkpoint::read( checkpointFile, fingerprint, regions, tightenings ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_CHECKPOINT );
+    }
+
+    void test_read_mismatched_fingerprint()
+    {
+        List<PiecewiseLinearCaseSplit> regions = { PiecewiseLinearCaseSplit() };
+        Checkpoint::write( checkpointFile, fingerprint, regions, List<Tightening>() );
+
+        List<PiecewiseLinearCaseSplit> readRegions;
+        List<Tightening> readTightenings;
+        TS_ASSERT_THROWS_EQUALS( Checkpoint::read( checkpointFile, "fedcba9876543210",
+                                                   readRegions, readTightenings ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::CHECKPOINT_MISMATCH );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
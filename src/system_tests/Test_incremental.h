@@ -0,0 +1,401 @@
+/*********************                                                        */
+/*! \file Test_incremental.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** System tests for incremental solving: many properties of one ACAS Xu
+ ** network, with or without disjunctions, are solved on a single engine,
+ ** and compared with solving each of them from scratch.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "AcasParser.h"
+#include "DisjunctionConstraint.h"
+#include "Engine.h"
+#include "FloatUtils.h"
+#include "InputQuery.h"
+#include "MarabouError.h"
+#include "NetworkLevelReasoner.h"
+
+class IncrementalTestSuite : public CxxTest::TestSuite
+{
+public:
+    InputQuery _network;
+    AcasParser *_acasParser;
+
+    void setUp()
+    {
+        _acasParser = new AcasParser( RESOURCES_DIR "/nnet/acasxu/ACASXU_experimental_v2a_1_1.nnet" );
+        _network = InputQuery();
+        _acasParser->generateQuery( _network );
+    }
+
+    void tearDown()
+    {
+        delete _acasParser;
+    }
+
+    /*
+      A property: the inputs lie in a box of the given radius around a
+      point, and the first output is at least (GE) or at most (LE) the
+      given value.
+    */
+    struct Property
+    {
+        Vector<double> _point;
+        double _radius;
+        Equation::EquationType _type;
+        double _value;
+    };
+
+    Vector<double> outputs( const Vector<double> &point )
+    {
+        Vector<double> input( point );
+        Vector<double> output( _acasParser->getNumOutputVariables() );
+        _network.getNetworkLevelReasoner()->evaluate( input.data(), output.data() );
+        return output;
+    }
+
+    double firstOutput( const Vector<double> &point )
+    {
+        return outputs( point )[0];
+    }
+
+    Equation outputEquation( const Property &property )
+    {
+        Equation equation( property._type );
+        equation.addAddend( 1, _acasParser->getOutputVariable( 0 ) );
+        equation.setScalar( property._value );
+        return equation;
+    }
+
+    void addBox( Engine &engine, const Vector<double> &point, double radius )
+    {
+        for ( unsigned i = 0; i < point.size(); ++i )
+        {
+            unsigned variable = _acasParser->getInputVariable( i );
+            engine.addPropertyBound( Tightening( variable, point[i] - radius, Tightening::LB ) );
+            engine.addPropertyBound( Tightening( variable, point[i] + radius, Tightening::UB ) );
+        }
+    }
+
+    void addProperty( Engine &engine, const Property &property )
+    {
+        addBox( engine, property._point, property._radius );
+        engine.addPropertyEquation( outputEquation( property ) );
+    }
+
+    void setBox( InputQuery &inputQuery, const Vector<double> &point, double radius )
+    {
+        for ( unsigned i = 0; i < point.size(); ++i )
+        {
+            unsigned variable = _acasParser->getInputVariable( i );
+            inputQuery.setLowerBound( variable, point[i] - radius );
+            inputQuery.setUpperBound( variable, point[i] + radius );
+        }
+    }
+
+    IEngine::ExitCode solve( InputQuery &inputQuery )
+    {
+        Engine engine;
+        if ( engine.processInputQuery( inputQuery ) )
+            engine.solve();
+        return engine.getExitCode();
+    }
+
+    IEngine::ExitCode solveFromScratch( const Property &property )
+    {
+        InputQuery inputQuery = _network;
+        setBox( inputQuery, property._point, property._radius );
+        inputQuery.addEquation( outputEquation( property ) );
+        return solve( inputQuery );
+    }
+
+    Vector<double> extractInput( Engine &engine )
+    {
+        InputQuery solution;
+        solution.setNumberOfVariables( _network.getNumberOfVariables() );
+        engine.extractSolution( solution );
+
+        Vector<double> input;
+        for ( unsigned i = 0; i < _acasParser->getNumInputVaribales(); ++i )
+            input.append( solution.getSolutionValue( _acasParser->getInputVariable( i ) ) );
+        return input;
+    }
+
+    void checkInBox( const Vector<double> &input, const Vector<double> &point, double radius )
+    {
+        for ( unsigned i = 0; i < point.size(); ++i )
+        {
+            TS_ASSERT( FloatUtils::gte( input[i], point[i] - radius, 1e-6 ) );
+            TS_ASSERT( FloatUtils::lte( input[i], point[i] + radius, 1e-6 ) );
+        }
+    }
+
+    void checkSolution( Engine &engine, const Property &property )
+    {
+        Vector<double> input = extractInput( engine );
+        checkInBox( input, property._point, property._radius );
+
+        double output = firstOutput( input );
+        if ( property._type == Equation::GE )
+        {
+            TS_ASSERT( FloatUtils::gte( output, property._value, 1e-4 ) );
+        }
+        else
+        {
+            TS_ASSERT( FloatUtils::lte( output, property._value, 1e-4 ) );
+        }
+    }
+
+    List<Vector<double>> points()
+    {
+        return {
+            Vector<double>( { -0.31182839647533234, 0.0, -0.2387324146378273, -0.5, -0.4166666666666667 } ),
+            Vector<double>( { -0.16247807039378703, -0.4774648292756546, -0.2387324146378273, -0.3181818181818182, -0.25 } ),
+            Vector<double>( { -0.2454504737724233, -0.4774648292756546, 0.0, -0.3181818181818182, 0.0 } ),
+        };
+    }
+
+    List<Property> properties()
+    {
+        List<Property> properties;
+        for ( const auto &point : points() )
+        {
+            double value = firstOutput( point );
+
+            // The point itself is a witness
+            properties.append( Property( { point, 0.01, Equation::LE, value } ) );
+            properties.append( Property( { point, 0.01, Equation::GE, value } ) );
+            // Far away from the outputs in the box
+            properties.append( Property( { point, 0.01, Equation::GE, value + 1000 } ) );
+            properties.append( Property( { point, 0.01, Equation::LE, value - 1000 } ) );
+        }
+        return properties;
+    }
+
+    unsigned advisory( const Vector<double> &scores )
+    {
+        unsigned advisory = 0;
+        for ( unsigned i = 1; i < scores.size(); ++i )
+            if ( scores[i] < scores[advisory] )
+                advisory = i;
+        return advisory;
+    }
+
+    /*
+      The advisory is the output with the smallest score. The disjunction
+      holds if the score of another output is at most that of the
+      advisory at the point.
+    */
+    List<PiecewiseLinearCaseSplit> advisoryChanges( const Vector<double> &point )
+    {
+        unsigned current = advisory( outputs( point ) );
+
+        List<PiecewiseLinearCaseSplit> disjuncts;
+        for ( unsigned i = 0; i < _acasParser->getNumOutputVariables(); ++i )
+        {
+            if ( i == current )
+                continue;
+
+            Equation equation( Equation::LE );
+            equation.addAddend( 1, _acasParser->getOutputVariable( i ) );
+            equation.addAddend( -1, _acasParser->getOutputVariable( current ) );
+            equation.setScalar( 0 );
+
+            PiecewiseLinearCaseSplit disjunct;
+            disjunct.addEquation( equation );
+            disjuncts.append( disjunct );
+        }
+        return disjuncts;
+    }
+
+    void test_properties_match_solving_from_scratch()
+    {
+        InputQuery network = _network;
+        Engine engine;
+        TS_ASSERT( engine.processInputQuery( network ) );
+
+        unsigned numberOfSat = 0;
+        unsigned numberOfUnsat = 0;
+        for ( const auto &property : properties() )
+        {
+            engine.push();
+            addProperty( engine, property );
+            engine.solveIncrementally();
+
+            IEngine::ExitCode exitCode = engine.getExitCode();
+            TS_ASSERT_EQUALS( exitCode, solveFromScratch( property ) );
+            if ( exitCode == IEngine::SAT )
+            {
+                checkSolution( engine, property );
+                ++numberOfSat;
+            }
+            else if ( exitCode == IEngine::UNSAT )
+                ++numberOfUnsat;
+
+            engine.pop();
+            TS_ASSERT_EQUALS( engine.getNumberOfScopes(), 0U );
+        }
+
+        TS_ASSERT( numberOfSat >= 6 );
+        TS_ASSERT( numberOfUnsat >= 6 );
+    }
+
+    void test_nested_scopes()
+    {
+        InputQuery network = _network;
+        Engine engine;
+        TS_ASSERT( engine.processInputQuery( network ) );
+
+        Property property = properties().front();
+        double value = property._value;
+
+        // The box is shared by the properties in the inner scopes
+        engine.push();
+        property._type = Equation::GE;
+        property._value = value + 1000;
+        addProperty( engine, property );
+        TS_ASSERT( !engine.solveIncrementally() );
+        TS_ASSERT_EQUALS( engine.getExitCode(), IEngine::UNSAT );
+        engine.pop();
+
+        engine.push();
+        property._type = Equation::LE;
+        property._value = value;
+        addProperty( engine, property );
+        TS_ASSERT( engine.solveIncrementally() );
+        checkSolution( engine, property );
+
+        // Solving again, with a tighter property in a nested scope
+        engine.push();
+        engine.addPropertyEquation( outputEquation( Property( { property._point, 0, Equation::GE, value + 1000 } ) ) );
+        TS_ASSERT_EQUALS( engine.getNumberOfScopes(), 2U );
+        TS_ASSERT( !engine.solveIncrementally() );
+        engine.pop();
+
+        TS_ASSERT( engine.solveIncrementally() );
+        checkSolution( engine, property );
+        engine.pop();
+        TS_ASSERT_EQUALS( engine.getNumberOfScopes(), 0U );
+
+        TS_ASSERT_THROWS_EQUALS( engine.pop(),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::NO_SCOPE_TO_POP );
+    }
+
+    void test_epsilon_sweep_matches_solving_from_scratch()
+    {
+        InputQuery network = _network;
+        Engine engine;
+        TS_ASSERT( engine.processInputQuery( network ) );
+
+        unsigned numberOfSat = 0;
+        unsigned numberOfUnsat = 0;
+        for ( const auto &point : points() )
+        {
+            List<PiecewiseLinearCaseSplit> disjuncts = advisoryChanges( point );
+            unsigned current = advisory( outputs( point ) );
+
+            for ( double radius : { 0.001, 0.01, 0.05 } )
+            {
+                engine.push();
+                addBox( engine, point, radius );
+                engine.addPropertyDisjunction( disjuncts );
+                engine.solveIncrementally();
+
+                InputQuery inputQuery = _network;
+                setBox( inputQuery, point, radius );
+                inputQuery.addPiecewiseLinearConstraint( new DisjunctionConstraint( disjuncts ) );
+
+                IEngine::ExitCode exitCode = engine.getExitCode();
+                TS_ASSERT_EQUALS( exitCode, solve( inputQuery ) );
+                if ( exitCode == IEngine::SAT )
+                {
+                    Vector<double> input = extractInput( engine );
+                    checkInBox( input, point, radius );
+
+                    // Another output is at most as large as the advisory
+                    Vector<double> scores = outputs( input );
+                    bool changed = false;
+                    for ( unsigned i = 0; i < scores.size(); ++i )
+                        if ( i != current && FloatUtils::lte( scores[i], scores[current], 1e-4 ) )
+                            changed = true;
+                    TS_ASSERT( changed );
+                    ++numberOfSat;
+                }
+                else if ( exitCode == IEngine::UNSAT )
+                    ++numberOfUnsat;
+
+                engine.pop();
+            }
+        }
+
+        TS_ASSERT( numberOfSat >= 1 );
+        TS_ASSERT( numberOfUnsat >= 1 );
+    }
+
+    void test_several_disjunctions()
+    {
+        InputQuery network = _network;
+        Engine engine;
+        TS_ASSERT( engine.processInputQuery( network ) );
+
+        Vector<double> point = points().front();
+        double value = firstOutput( point );
+
+        auto disjunct = [&]( Equation::EquationType type, double value )
+        {
+            PiecewiseLinearCaseSplit split;
+            split.addEquation( outputEquation( Property( { point, 0, type, value } ) ) );
+            return split;
+        };
+
+        // Only the second disjuncts of both disjunctions hold together,
+        // when the first output equals its value at the point
+        engine.push();
+        addBox( engine, point, 0.01 );
+        engine.addPropertyDisjunction( { disjunct( Equation::GE, value + 1000 ),
+                                         disjunct( Equation::LE, value ) } );
+        engine.addPropertyDisjunction( { disjunct( Equation::LE, value - 1000 ),
+                                         disjunct( Equation::GE, value ) } );
+        TS_ASSERT( engine.solveIncrementally() );
+        Vector<double> input = extractInput( engine );
+        checkInBox( input, point, 0.01 );
+        TS_ASSERT( FloatUtils::areEqual( firstOutput( input ), value, 1e-4 ) );
+
+        // A disjunction without disjuncts never holds
+        engine.push();
+        engine.addPropertyDisjunction( List<PiecewiseLinearCaseSplit>() );
+        TS_ASSERT( !engine.solveIncrementally() );
+        TS_ASSERT_EQUALS( engine.getExitCode(), IEngine::UNSAT );
+        engine.pop();
+
+        // Nor does one that contradicts both of the others
+        engine.push();
+        engine.addPropertyDisjunction( { disjunct( Equation::GE, value + 1000 ),
+                                         disjunct( Equation::LE, value - 1000 ) } );
+        TS_ASSERT( !engine.solveIncrementally() );
+        TS_ASSERT_EQUALS( engine.getExitCode(), IEngine::UNSAT );
+        engine.pop();
+
+        TS_ASSERT( engine.solveIncrementally() );
+        engine.pop();
+        TS_ASSERT_EQUALS( engine.getNumberOfScopes(), 0U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
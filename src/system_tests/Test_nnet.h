@@ -0,0 +1,182 @@
+/*********************                                                        */
+/*! \file Test_nnet.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** System tests for the .nnet parser: lines of any length and line
+ ** ending, and the network level reasoner built along with the query.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "AcasParser.h"
+#include "AutoFile.h"
+#include "FloatUtils.h"
+#include "InputQuery.h"
+#include "MStringf.h"
+#include "NetworkLevelReasoner.h"
+
+#include <cstdio>
+#include <fstream>
+
+const String NNET_TEST_FILE( "Test_nnet.nnet" );
+
+class NnetTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+        std::remove( NNET_TEST_FILE.ascii() );
+    }
+
+    void writeNetwork( const String &contents )
+    {
+        AutoFile file( NNET_TEST_FILE );
+        file->open( IFile::MODE_WRITE_TRUNCATE );
+        file->write( contents );
+    }
+
+    String repeat( const String &value, unsigned times )
+    {
+        String row;
+        for ( unsigned i = 0; i < times; ++i )
+            row += value;
+        return row + "\n";
+    }
+
+    void evaluateNlr( InputQuery &inputQuery, const Vector<double> &inputs, Vector<double> &outputs )
+    {
+        NLR::NetworkLevelReasoner *nlr = inputQuery.getNetworkLevelReasoner();
+        TS_ASSERT( nlr );
+        unsigned numberOfOutputs = nlr->getLayer( nlr->getNumberOfLayers() - 1 )->getSize();
+
+        Vector<double> input( inputs );
+        outputs = Vector<double>( numberOfOutputs );
+        nlr->evaluate( input.data(), outputs.data() );
+    }
+
+    void test_row_longer_than_line_buffer()
+    {
+        // 5000 inputs -> 1 ReLU -> 1 output. The row of weights into the
+        // hidden neuron is 45000 characters long, more than the 40960
+        // characters the parser used to read per line.
+        const unsigned numberOfInputs = 5000;
+
+        String contents = "// A network with a long row\n";
+        contents += Stringf( "2,%u,1,%u,\n%u,1,1,\n0,\n", numberOfInputs, numberOfInputs, numberOfInputs );
+        // Input minimums and maximums, then means and ranges of the inputs
+        // and of the output
+        contents += repeat( "0.0,", numberOfInputs );
+        contents += repeat( "1.0,", numberOfInputs );
+        contents += repeat( "0.0,", numberOfInputs + 1 );
+        contents += repeat( "1.0,", numberOfInputs + 1 );
+
+        contents += repeat( "0.000100,", numberOfInputs );
+        contents += "-0.25,\n2.0,\n1.0,\n";
+
+        TS_ASSERT( contents.length() > 40960 );
+        writeNetwork( contents );
+
+        InputQuery inputQuery;
+        AcasParser acasParser( NNET_TEST_FILE );
+        acasParser.generateQuery( inputQuery );
+
+        // All weights are read: relu( 5000 * 0.0001 - 0.25 ) * 2 + 1 = 1.5
+        Vector<double> inputs( numberOfInputs, 1.0 );
+        Vector<double> outputs;
+        acasParser.evaluate( inputs, outputs );
+        TS_ASSERT_EQUALS( outputs.size(), 1U );
+        TS_ASSERT( FloatUtils::areEqual( outputs[0], 1.5 ) );
+
+        evaluateNlr( inputQuery, inputs, outputs );
+        TS_ASSERT( FloatUtils::areEqual( outputs[0], 1.5 ) );
+    }
+
+    void test_crlf_and_trailing_blank_lines()
+    {
+        AcasParser original( RESOURCES_DIR "/nnet/fc_2-2-3.nnet" );
+        InputQuery originalQuery;
+        original.generateQuery( originalQuery );
+
+        // The same network, with Windows line endings and blank lines at
+        // the end
+        String contents;
+        std::ifstream file( RESOURCES_DIR "/nnet/fc_2-2-3.nnet" );
+        std::string line;
+        while ( std::getline( file, line ) )
+            contents += String( line.c_str() ) + "\r\n";
+        contents += "\r\n\r\n\n";
+        writeNetwork( contents );
+
+        InputQuery inputQuery;
+        AcasParser acasParser( NNET_TEST_FILE );
+        acasParser.generateQuery( inputQuery );
+
+        TS_ASSERT( originalQuery.getEquations() == inputQuery.getEquations() );
+        TS_ASSERT( originalQuery.getLowerBounds() == inputQuery.getLowerBounds() );
+        TS_ASSERT( originalQuery.getUpperBounds() == inputQuery.getUpperBounds() );
+
+        for ( const auto &inputs : { Vector<double>( { 0, 0 } ),
+                                     Vector<double>( { 1, -2 } ),
+                                     Vector<double>( { -3.5, 0.25 } ) } )
+        {
+            Vector<double> expected;
+            original.evaluate( inputs, expected );
+            Vector<double> outputs;
+            acasParser.evaluate( inputs, outputs );
+            TS_ASSERT_EQUALS( outputs, expected );
+        }
+    }
+
+    void test_nlr_matches_constructed_nlr()
+    {
+        InputQuery inputQuery;
+        AcasParser acasParser( RESOURCES_DIR "/nnet/acasxu/ACASXU_experimental_v2a_1_1.nnet" );
+        acasParser.generateQuery( inputQuery );
+
+        // Recover the reasoner from the equations, as callers used to
+        InputQuery constructedQuery = inputQuery;
+        TS_ASSERT( constructedQuery.constructNetworkLevelReasoner() );
+
+        NLR::NetworkLevelReasoner *nlr = inputQuery.getNetworkLevelReasoner();
+        NLR::NetworkLevelReasoner *constructedNlr = constructedQuery.getNetworkLevelReasoner();
+        TS_ASSERT_EQUALS( nlr->getNumberOfLayers(), constructedNlr->getNumberOfLayers() );
+        for ( unsigned i = 0; i < nlr->getNumberOfLayers(); ++i )
+        {
+            TS_ASSERT_EQUALS( nlr->getLayer( i )->getLayerType(),
+                              constructedNlr->getLayer( i )->getLayerType() );
+            TS_ASSERT_EQUALS( nlr->getLayer( i )->getSize(),
+                              constructedNlr->getLayer( i )->getSize() );
+        }
+
+        for ( const auto &inputs : { Vector<double>( { 0, 0, 0, 0, 0 } ),
+                                     Vector<double>( { 0.5, -0.25, 0.1, 0.3, -0.4 } ),
+                                     Vector<double>( { -0.3, 0.45, -0.2, -0.1, 0.2 } ) } )
+        {
+            Vector<double> outputs;
+            evaluateNlr( inputQuery, inputs, outputs );
+            Vector<double> constructedOutputs;
+            evaluateNlr( constructedQuery, inputs, constructedOutputs );
+
+            for ( unsigned i = 0; i < outputs.size(); ++i )
+                TS_ASSERT( FloatUtils::areEqual( outputs[i], constructedOutputs[i] ) );
+        }
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,161 @@
+/*********************                                                        */
+/*! \file Test_onnx.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** System tests for the ONNX parser: the encoded networks are solved with
+ ** fixed inputs, and the solutions are checked against the network level
+ ** reasoner that the parser constructs.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "AcasParser.h"
+#include "Engine.h"
+#include "FloatUtils.h"
+#include "InputParserError.h"
+#include "InputQuery.h"
+#include "NetworkLevelReasoner.h"
+#include "OnnxParser.h"
+
+class OnnxTestSuite : public CxxTest::TestSuite
+{
+public:
+
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    /*
+      Fix the inputs of the network, evaluate it with the network level
+      reasoner, solve the query and check that the solution agrees.
+    */
+    void solveWithFixedInputs( const String &path )
+    {
+        InputQuery inputQuery;
+        OnnxParser onnxParser( path );
+        TS_ASSERT_THROWS_NOTHING( onnxParser.generateQuery( inputQuery ) );
+
+        unsigned numInputs = onnxParser.getNumInputVariables();
+        unsigned numOutputs = onnxParser.getNumOutputVariables();
+
+        Vector<double> inputs;
+        for ( unsigned i = 0; i < numInputs; ++i )
+        {
+            double value = ( ( i * 37 ) % 11 ) / 10.0 - 0.5;
+            inputs.append( value );
+
+            unsigned variable = onnxParser.getInputVariable( i );
+            inputQuery.setLowerBound( variable, value );
+            inputQuery.setUpperBound( variable, value );
+        }
+
+        NLR::NetworkLevelReasoner *nlr = inputQuery.getNetworkLevelReasoner();
+        TS_ASSERT( nlr );
+
+        Vector<double> outputs( numOutputs, 0 );
+        TS_ASSERT_THROWS_NOTHING( nlr->evaluate( inputs.data(), outputs.data() ) );
+
+        Engine engine;
+        TS_ASSERT( engine.processInputQuery( inputQuery ) );
+        TS_ASSERT_THROWS_NOTHING( engine.solve() );
+        TS_ASSERT_EQUALS( engine.getExitCode(), Engine::SAT );
+        engine.extractSolution( inputQuery );
+
+        for ( unsigned i = 0; i < numOutputs; ++i )
+        {
+            unsigned variable = onnxParser.getOutputVariable( i );
+            TS_ASSERT( FloatUtils::areEqual( outputs[i],
+                                             inputQuery.getSolutionValue( variable ),
+                                             0.0001 ) );
+        }
+    }
+
+    void test_fully_connected_matches_nnet()
+    {
+        InputQuery onnxQuery;
+        OnnxParser onnxParser( RESOURCES_DIR "/onnx/fc_2-2-3.onnx" );
+        onnxParser.generateQuery( onnxQuery );
+
+        InputQuery acasQuery;
+        AcasParser acasParser( RESOURCES_DIR "/nnet/fc_2-2-3.nnet" );
+        acasParser.generateQuery( acasQuery );
+
+        TS_ASSERT_EQUALS( onnxParser.getNumInputVariables(), 2U );
+        TS_ASSERT_EQUALS( onnxParser.getNumOutputVariables(), 3U );
+
+        NLR::NetworkLevelReasoner *nlr = onnxQuery.getNetworkLevelReasoner();
+        TS_ASSERT( nlr );
+
+        double points[][2] = { { 0, 0 }, { 1, -1 }, { -0.5, 2 }, { 3, 0.25 } };
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            Vector<double> inputs;
+            inputs.append( points[i][0] );
+            inputs.append( points[i][1] );
+
+            Vector<double> expected;
+            acasParser.evaluate( inputs, expected );
+
+            double outputs[3];
+            nlr->evaluate( inputs.data(), outputs );
+
+            for ( unsigned j = 0; j < 3; ++j )
+                TS_ASSERT( FloatUtils::areEqual( outputs[j], expected[j], 0.00001 ) );
+        }
+    }
+
+    void test_gemm_and_relu()
+    {
+        solveWithFixedInputs( RESOURCES_DIR "/onnx/fc1.onnx" );
+    }
+
+    void test_matmul_and_add()
+    {
+        solveWithFixedInputs( RESOURCES_DIR "/onnx/mnist2x10.onnx" );
+    }
+
+    void test_batch_normalization()
+    {
+        solveWithFixedInputs( RESOURCES_DIR "/onnx/linear2-3_bn1-linear3-1.onnx" );
+    }
+
+    void test_conv_maxpool_and_transpose()
+    {
+        solveWithFixedInputs( RESOURCES_DIR "/onnx/conv_mp1.onnx" );
+    }
+
+    void test_unsupported_operation()
+    {
+        InputQuery inputQuery;
+        OnnxParser onnxParser( RESOURCES_DIR "/onnx/fc_2-2sigmoids-3.onnx" );
+        TS_ASSERT_THROWS_EQUALS( onnxParser.generateQuery( inputQuery ),
+                                 const InputParserError &e,
+                                 e.getCode(),
+                                 InputParserError::UNSUPPORTED_OPERATION );
+    }
+
+    void test_is_onnx_file()
+    {
+        TS_ASSERT( OnnxParser::isOnnxFile( "network.onnx" ) );
+        TS_ASSERT( !OnnxParser::isOnnxFile( "network.nnet" ) );
+        TS_ASSERT( !OnnxParser::isOnnxFile( "onnx" ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//